@@ -38,10 +38,16 @@ if [ ! -d blst_asm ]; then
   cd ..
 fi
 
-g++ -Iblst_asm -march=native -O3  src/test_evm384.cpp src/assembly.S src/blst_evm384_no_asm.cpp -o test_evm384
+g++ -Iblst_asm -march=native -O3 -pthread  src/test_evm384.cpp src/assembly.S src/blst_evm384_no_asm.cpp src/fp.cpp src/ec_g1.cpp src/msm_g1.cpp src/fp12.cpp src/pairing.cpp src/trace.cpp src/batch.cpp src/blst_evm384_vartime.cpp -o test_evm384
 
 ./test_evm384
 
-g++ -Iblst_asm -march=native -O3  src/perf.cpp src/bench_evm384.cpp src/assembly.S src/blst_evm384_no_asm.cpp -o bench_evm384
+g++ -Iblst_asm -march=native -O3 -pthread  src/perf.cpp src/bench_evm384.cpp src/calibrate.cpp src/working_set.cpp src/batch.cpp src/multicore.cpp src/assembly.S src/blst_evm384_no_asm.cpp src/blst_evm384_vartime.cpp -o bench_evm384
 
 ./bench_evm384
+
+g++ -Iblst_asm -march=native -O3 -pthread  src/perf.cpp src/bench_msm.cpp src/assembly.S src/fp.cpp src/ec_g1.cpp src/msm_g1.cpp -o bench_msm
+
+g++ -Iblst_asm -march=native -O3 -DEVM384_COUNT_OPS  src/perf.cpp src/bench_pairing.cpp src/assembly.S src/fp.cpp src/ec_g1.cpp src/fp12.cpp src/pairing.cpp -o bench_pairing
+
+g++ -Iblst_asm -march=native -O3 -DEVM384_TRACE_OPS  src/perf.cpp src/replay_trace.cpp src/trace.cpp src/assembly.S src/fp.cpp src/ec_g1.cpp src/fp12.cpp src/pairing.cpp -o replay_trace
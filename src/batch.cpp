@@ -0,0 +1,41 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include "batch.h"
+
+// A vec384 is 48 bytes, so every 64 byte line holds the start of at least
+// one element and prefetching each element's first byte covers the arrays
+static inline void batch_prefetch(vec384 ret[], const vec384 a[],
+                                  const vec384 b[], size_t i, size_t n) {
+  if (i + BATCH_PREFETCH_DISTANCE < n) {
+    __builtin_prefetch(a[i + BATCH_PREFETCH_DISTANCE], 0, 3);
+    __builtin_prefetch(b[i + BATCH_PREFETCH_DISTANCE], 0, 3);
+    __builtin_prefetch(ret[i + BATCH_PREFETCH_DISTANCE], 1, 3);
+  }
+}
+
+void add_mod_384_batch(vec384 ret[], const vec384 a[], const vec384 b[],
+                       const vec384 p, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    batch_prefetch(ret, a, b, i, n);
+    add_mod_384(ret[i], a[i], b[i], p);
+  }
+}
+
+void sub_mod_384_batch(vec384 ret[], const vec384 a[], const vec384 b[],
+                       const vec384 p, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    batch_prefetch(ret, a, b, i, n);
+    sub_mod_384(ret[i], a[i], b[i], p);
+  }
+}
+
+void mul_mont_384_batch(vec384 ret[], const vec384 a[], const vec384 b[],
+                        const vec384 p, uint64_t n0, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    batch_prefetch(ret, a, b, i, n);
+    mul_mont_384(ret[i], a[i], b[i], p, n0);
+  }
+}
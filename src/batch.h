@@ -0,0 +1,29 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_BATCH_H__
+#define __SUPRANATIONAL_BATCH_H__
+
+#include <cstdint>
+#include <cstddef>
+#include "blst_evm384.h"
+
+// Elementwise kernels over operand arrays, ret[i] = a[i] op b[i] for i < n.
+// Each step prefetches the operands BATCH_PREFETCH_DISTANCE elements ahead
+// so that arrays streaming from L3 or DRAM arrive before the kernel needs
+// them.  ret may be the same array as a or b.
+
+// 16 elements covers DRAM latency at add/sub speed, tune per host
+#ifndef BATCH_PREFETCH_DISTANCE
+# define BATCH_PREFETCH_DISTANCE 16
+#endif
+
+void add_mod_384_batch(vec384 ret[], const vec384 a[], const vec384 b[],
+                       const vec384 p, size_t n);
+void sub_mod_384_batch(vec384 ret[], const vec384 a[], const vec384 b[],
+                       const vec384 p, size_t n);
+void mul_mont_384_batch(vec384 ret[], const vec384 a[], const vec384 b[],
+                        const vec384 p, uint64_t n0, size_t n);
+
+#endif /* __SUPRANATIONAL_BATCH_H__ */
@@ -125,4 +125,57 @@ typedef void (*bench_func_ptr_t)(Perf*,
     benchVec.push_back(Bench##funcName##NotDependent);
 #endif /* BENCH_ONLY_SERIAL_DEPENDENCE */
 
+// Benches a function of two independent operations, func(dest[2], x[2], y[2],
+// ...), in latency (Same, each result feeds its next call) and throughput
+// (Diff) mode regardless of BENCH_ONLY_SERIAL_DEPENDENCE.  Reports cycles per
+// call, i.e. per pair of operations.
+#define BENCH_FUNC_PAIR(outIters, inIters, funcName, func, ...)\
+  void Bench##funcName##Same(Perf* perf,\
+    std::uniform_int_distribution<uint64_t>& rng,\
+    std::uniform_int_distribution<uint64_t>& rng_upper,\
+    std::vector<BenchResult>& results) {\
+  \
+    uint64_t  x[2][6];\
+    uint64_t  y[2][6];\
+    uint64_t  (*dest)[6] = x;\
+  \
+    std::mt19937_64 gen(1);\
+    for (int k = 0; k < 2; ++k) {\
+      for (int i = 0; i < 5; ++i) {\
+        x[k][i] = rng(gen);\
+        y[k][i] = rng(gen);\
+      }\
+      x[k][5] = rng_upper(gen);\
+      y[k][5] = rng_upper(gen);\
+    }\
+  \
+    WARM_UP_AND_BENCH(funcName, Same, outIters, inIters, func, __VA_ARGS__)\
+  }\
+  \
+  void Bench##funcName##Diff(Perf* perf,\
+    std::uniform_int_distribution<uint64_t>& rng,\
+    std::uniform_int_distribution<uint64_t>& rng_upper,\
+    std::vector<BenchResult>& results) {\
+  \
+    uint64_t  x[2][6];\
+    uint64_t  y[2][6];\
+    uint64_t  dest[2][6];\
+  \
+    std::mt19937_64 gen(1);\
+    for (int k = 0; k < 2; ++k) {\
+      for (int i = 0; i < 5; ++i) {\
+        x[k][i] = rng(gen);\
+        y[k][i] = rng(gen);\
+      }\
+      x[k][5] = rng_upper(gen);\
+      y[k][5] = rng_upper(gen);\
+    }\
+  \
+    WARM_UP_AND_BENCH(funcName, Diff, outIters, inIters, func, __VA_ARGS__)\
+  }
+
+#define ADD_BENCH_FUNC_PAIR(funcName, benchVec)\
+  benchVec.push_back(Bench##funcName##Same);\
+  benchVec.push_back(Bench##funcName##Diff);
+
 #endif /* __SUPRANATIONAL_BENCH_H__ */
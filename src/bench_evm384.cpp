@@ -23,10 +23,16 @@
 #include <ctime>
 #include <random>
 #include <cstring>
+#include <fstream>
 
 
 #include "bench.h"
 #include "blst_evm384.h"
+#include "blst_evm384_inline.h"
+#include "blst_evm384_vartime.h"
+#include "calibrate.h"
+#include "working_set.h"
+#include "multicore.h"
 
 // Outer iterations are number of bench runs to perform per function
 // Inner iterations are the number of times to run the function in a timed loop
@@ -51,48 +57,132 @@ BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384MulBLS381, mul_mont_384,
 BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384MulNoAsmBLS381,
            mul_mont_384_no_asm, dest, x, y, BLS12_381_P, BLS12_381_p0)
 
+BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384AddInlineBLS381,
+           add_mod_384_inline, dest, x, y, BLS12_381_P)
+
+BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384SubInlineBLS381,
+           sub_mod_384_inline, dest, x, y, BLS12_381_P)
+
+// Variable time kernels, for public inputs only
+BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384AddVartimeBLS381,
+           add_mod_384_vartime, dest, x, y, BLS12_381_P)
+
+BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384SubVartimeBLS381,
+           sub_mod_384_vartime, dest, x, y, BLS12_381_P)
+
+typedef void (*add_sub_func_t)(vec384, const vec384, const vec384,
+                               const vec384);
+
+// Chain of 16 alternating adds and subs, each feeding the next.  The
+// accumulator is local so that it never aliases an operand, even when Same
+// passes ret == a, otherwise the inlined sub(ret, ret, a) folds to zero.
+template <add_sub_func_t add, add_sub_func_t sub>
+static void add_sub_chain_16(vec384 ret, const vec384 a, const vec384 b,
+                             const vec384 p) {
+  vec384 acc;
+
+  add(acc, a, b, p);
+  for (int i = 0; i < 7; i++) {
+    sub(acc, acc, a, p);
+    add(acc, acc, b, p);
+  }
+  sub(acc, acc, a, p);
+
+  for (int i = 0; i < 6; i++)
+    ret[i] = acc[i];
+}
+
+BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384AddSubChain16BLS381,
+           (add_sub_chain_16<add_mod_384, sub_mod_384>),
+           dest, x, y, BLS12_381_P)
+
+BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384AddSubChain16InlineBLS381,
+           (add_sub_chain_16<add_mod_384_inline, sub_mod_384_inline>),
+           dest, x, y, BLS12_381_P)
+
+// Two back-to-back mul_mont_384 calls, the baseline for mul_mont_384x2
+static void mul_mont_384_pair(vec384 ret[2], const vec384 a[2],
+                              const vec384 b[2], const vec384 p, uint64_t n0) {
+  mul_mont_384(ret[0], a[0], b[0], p, n0);
+  mul_mont_384(ret[1], a[1], b[1], p, n0);
+}
+
+BENCH_FUNC_PAIR(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384MulPairBLS381,
+                mul_mont_384_pair, dest, x, y, BLS12_381_P, BLS12_381_p0)
+
+BENCH_FUNC_PAIR(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384Mulx2BLS381,
+                mul_mont_384x2, dest, x, y, BLS12_381_P, BLS12_381_p0)
+
 int main(int argc, char **argv) {
-  bool skip_cycle_check = false;
-  if (argc > 1) {
-    if (!strcmp("-skip-cycle-check", argv[1])) {
+  bool        skip_cycle_check = false;
+  bool        calibrate        = false;
+  const char* calibrate_out    = NULL;
+  double      gas_per_sec      = CALIBRATE_GAS_PER_SEC;
+  bool        working_set      = false;
+  size_t      working_set_max  = WORKING_SET_MAX_BYTES;
+  const char* placement        = NULL;
+  size_t      nthreads         = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp("-skip-cycle-check", argv[i])) {
       skip_cycle_check = true;
+    } else if (!strcmp("-calibrate", argv[i])) {
+      calibrate = true;
+    } else if (!strcmp("-calibrate-out", argv[i]) && i + 1 < argc) {
+      calibrate     = true;
+      calibrate_out = argv[++i];
+    } else if (!strcmp("-gas-per-sec", argv[i]) && i + 1 < argc) {
+      gas_per_sec = strtod(argv[++i], NULL);
+    } else if (!strcmp("-working-set", argv[i])) {
+      working_set = true;
+    } else if (!strcmp("-max-working-set-mb", argv[i]) && i + 1 < argc) {
+      working_set     = true;
+      working_set_max = strtoul(argv[++i], NULL, 0) << 20;
+    } else if (!strcmp("-multicore", argv[i]) && i + 1 < argc) {
+      placement = argv[++i];
+    } else if (!strcmp("-threads", argv[i]) && i + 1 < argc) {
+      nthreads = strtoul(argv[++i], NULL, 0);
     }
   }
 
   Perf perf(OUTER_ITERS_FAST, INNER_ITERS_FAST);
 
+  // With -calibrate the CSV goes to stdout unless -calibrate-out is given,
+  // so everything else is written to stderr to keep stdout parseable
+  std::ostream& info = calibrate ? std::cerr : std::cout;
+
   // Check for stable CPU clock frequency
   uint64_t  cycles_per_sec = perf.get_cycles_per_sec();
 
   if (cycles_per_sec == 0) {
     if (skip_cycle_check) {
-      std::cout << "Unstable frequency!! Proceeding anyway" << std::endl;
+      info << "Unstable frequency!! Proceeding anyway" << std::endl;
     } else {
-      std::cout << "Skipping benchmark runs - unstable frequency" << std::endl;
+      info << "Skipping benchmark runs - unstable frequency" << std::endl;
       return -1;
     }
   }
 
-  std::cout.imbue(std::locale(""));
-  std::cout << "CPU cyc/sec: " << std::fixed << cycles_per_sec << std::endl;
-  std::cout.imbue(std::locale());
-  std::cout << std::endl;
+  info.imbue(std::locale(""));
+  info << "CPU cyc/sec: " << std::fixed << cycles_per_sec << std::endl;
+  info.imbue(std::locale());
+  info << std::endl;
 
-  std::cout << "Benchmarking with parameters" << std::endl;
-  std::cout << "OUTER_ITERS_FAST: " << OUTER_ITERS_FAST << std::endl;
-  std::cout << "INNER_ITERS_FAST: " << INNER_ITERS_FAST << std::endl;
+  info << "Benchmarking with parameters" << std::endl;
+  info << "OUTER_ITERS_FAST: " << OUTER_ITERS_FAST << std::endl;
+  info << "INNER_ITERS_FAST: " << INNER_ITERS_FAST << std::endl;
 
-  std::cout << std::endl;
-  std::cout << "Compiler:         ";
+  info << std::endl;
+  info << "Compiler:         ";
 #ifdef __INTEL_COMPILER
-  std::cout << "Intel " << std::setprecision(1)
-            << (double)(__INTEL_COMPILER / 100) << std::endl;
+  info << "Intel " << std::setprecision(1)
+       << (double)(__INTEL_COMPILER / 100) << std::endl;
 #elif __clang__
-  std::cout << "clang " << __clang_version__ << std::endl;
+  info << "clang " << __clang_version__ << std::endl;
 #elif __GNUC__
-  std::cout << "GNU " << __GNUC__ << "." << __GNUC_MINOR__ << std::endl;
+  info << "GNU " << __GNUC__ << "." << __GNUC_MINOR__ << std::endl;
 #else
-  std::cout << "UNKNOWN" << std::endl;
+  info << "UNKNOWN" << std::endl;
 #endif
 
   std::uniform_int_distribution<uint64_t> 
@@ -105,7 +195,38 @@ int main(int argc, char **argv) {
 
   auto startClock = std::chrono::system_clock::now();
   std::time_t startTime = std::chrono::system_clock::to_time_t(startClock);
-  std::cout << "Run date: " << std::ctime(&startTime) << std::endl;
+  info << "Run date: " << std::ctime(&startTime) << std::endl;
+
+  if (working_set) {
+    run_working_set(&perf, working_set_max);
+
+    std::cout << std::endl;
+    auto endClock = std::chrono::system_clock::now();
+    std::chrono::duration<double> runTime = endClock - startClock;
+    std::cout << "Total runtime is: " << runTime.count() << " secs"
+              << std::endl;
+    return 0;
+  }
+
+  if (calibrate) {
+    if (calibrate_out != NULL) {
+      std::ofstream out(calibrate_out);
+
+      if (!out) {
+        info << "ERROR - could not create " << calibrate_out << std::endl;
+        return -1;
+      }
+      run_calibration(&perf, cycles_per_sec, gas_per_sec, out);
+    } else {
+      run_calibration(&perf, cycles_per_sec, gas_per_sec, std::cout);
+    }
+
+    info << std::endl;
+    auto endClock = std::chrono::system_clock::now();
+    std::chrono::duration<double> runTime = endClock - startClock;
+    info << "Total runtime is: " << runTime.count() << " secs" << std::endl;
+    return 0;
+  }
 
   /*
   std::vector<bench_func_ptr_t> benches = {
@@ -126,10 +247,29 @@ int main(int argc, char **argv) {
   std::vector<bench_func_ptr_t> benches;
   ADD_BENCH_FUNC(EVM384AddBLS381, benches);
   ADD_BENCH_FUNC(EVM384AddNoAsmBLS381, benches);
+  ADD_BENCH_FUNC(EVM384AddInlineBLS381, benches);
+  ADD_BENCH_FUNC(EVM384AddVartimeBLS381, benches);
   ADD_BENCH_FUNC(EVM384SubBLS381, benches);
   ADD_BENCH_FUNC(EVM384SubNoAsmBLS381, benches);
+  ADD_BENCH_FUNC(EVM384SubInlineBLS381, benches);
+  ADD_BENCH_FUNC(EVM384SubVartimeBLS381, benches);
   ADD_BENCH_FUNC(EVM384MulBLS381, benches);
   ADD_BENCH_FUNC(EVM384MulNoAsmBLS381, benches);
+  ADD_BENCH_FUNC(EVM384AddSubChain16BLS381, benches);
+  ADD_BENCH_FUNC(EVM384AddSubChain16InlineBLS381, benches);
+  ADD_BENCH_FUNC_PAIR(EVM384MulPairBLS381, benches);
+  ADD_BENCH_FUNC_PAIR(EVM384Mulx2BLS381, benches);
+
+  if (placement != NULL) {
+    int ret = run_multicore(benches, dist, dist_upper, placement, nthreads);
+
+    std::cout << std::endl;
+    auto endClock = std::chrono::system_clock::now();
+    std::chrono::duration<double> runTime = endClock - startClock;
+    std::cout << "Total runtime is: " << runTime.count() << " secs"
+              << std::endl;
+    return ret;
+  }
 
   std::vector<BenchResult> results;
 
@@ -0,0 +1,190 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <iostream>
+#include <iomanip>
+#include <locale>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <random>
+#include <thread>
+#include <cstring>
+#include <cstdlib>
+
+#include "perf.h"
+#include "msm_g1.h"
+
+// Range of MSM sizes, as log2 of the number of points
+#define MSM_MIN_LOG_POINTS 4
+#define MSM_MAX_LOG_POINTS 20
+
+// Large inputs take seconds per run, so fewer timed runs are collected
+#define MSM_OUTER_ITERS(npoints) \
+  ((npoints) <= (1 << 12) ? 10 : ((npoints) <= (1 << 16) ? 3 : 1))
+#define MSM_MAX_OUTER_ITERS 10
+
+struct MSMResult {
+  bool   equal;
+  size_t npoints;
+  size_t nthreads;
+  size_t wbits;
+  double cycles_per_msm;
+  double nsecs_per_msm;
+};
+
+int main(int argc, char **argv) {
+  bool   skip_cycle_check = false;
+  size_t max_log_points   = MSM_MAX_LOG_POINTS;
+  size_t max_threads      = std::thread::hardware_concurrency();
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp("-skip-cycle-check", argv[i])) {
+      skip_cycle_check = true;
+    } else if (!strcmp("-max-log-points", argv[i]) && i + 1 < argc) {
+      max_log_points = strtoul(argv[++i], NULL, 0);
+    } else if (!strcmp("-max-threads", argv[i]) && i + 1 < argc) {
+      max_threads = strtoul(argv[++i], NULL, 0);
+    }
+  }
+  if (max_threads == 0)
+    max_threads = 1;
+
+  Perf perf(MSM_MAX_OUTER_ITERS, 1);
+
+  // Check for stable CPU clock frequency
+  uint64_t  cycles_per_sec = perf.get_cycles_per_sec();
+
+  if (cycles_per_sec == 0) {
+    if (skip_cycle_check) {
+      std::cout << "Unstable frequency!! Proceeding anyway" << std::endl;
+    } else {
+      std::cout << "Skipping benchmark runs - unstable frequency" << std::endl;
+      return -1;
+    }
+  }
+
+  std::cout.imbue(std::locale(""));
+  std::cout << "CPU cyc/sec: " << std::fixed << cycles_per_sec << std::endl;
+  std::cout.imbue(std::locale());
+  std::cout << std::endl;
+
+  std::cout << "Benchmarking G1 MSM with parameters" << std::endl;
+  std::cout << "points:      2^" << MSM_MIN_LOG_POINTS << " - 2^"
+            << max_log_points << std::endl;
+  std::cout << "max threads: " << max_threads << std::endl;
+
+  auto startClock = std::chrono::system_clock::now();
+  std::time_t startTime = std::chrono::system_clock::to_time_t(startClock);
+  std::cout << "Run date: " << std::ctime(&startTime) << std::endl;
+
+  // Inputs are consecutive multiples of the generator and random scalars,
+  // then the same points with one scalar for all, as when verifying an
+  // aggregate signature
+  size_t            max_points = (size_t)1 << max_log_points;
+  POINTonE1*        jpoints    = new POINTonE1[max_points];
+  POINTonE1_affine* points     = new POINTonE1_affine[max_points];
+  vec256*           scalars    = new vec256[max_points];
+  vec256*           equal      = new vec256[max_points];
+  POINTonE1         acc, out;
+
+  std::mt19937_64 gen(1);
+
+  std::uniform_int_distribution<uint64_t>
+    dist(0, std::numeric_limits<uint64_t>::max());
+
+  // RNG for last limb to ensure scalar < order
+  std::uniform_int_distribution<uint64_t>
+    dist_upper(0, BLS12_381_r[3]);
+
+  POINTonE1_from_affine(&acc, &BLS12_381_G1);
+  for (size_t i = 0; i < max_points; i++) {
+    jpoints[i] = acc;
+    POINTonE1_add_affine(&acc, &acc, &BLS12_381_G1);
+    for (size_t k = 0; k < 3; k++) {
+      scalars[i][k] = dist(gen);
+    }
+    scalars[i][3] = dist_upper(gen);
+    std::memcpy(equal[i], scalars[0], sizeof(vec256));
+  }
+  POINTonE1_batch_to_affine(points, jpoints, max_points);
+  delete[] jpoints;
+
+  // Powers of two up to and including max_threads
+  std::vector<size_t> thread_counts;
+  for (size_t nthreads = 1; nthreads < max_threads; nthreads *= 2)
+    thread_counts.push_back(nthreads);
+  thread_counts.push_back(max_threads);
+
+  std::vector<MSMResult> results;
+
+  for (int eq = 0; eq < 2; eq++) {
+    const vec256* input = eq ? equal : scalars;
+
+    for (size_t log_n = MSM_MIN_LOG_POINTS; log_n <= max_log_points;
+         log_n++) {
+      size_t npoints    = (size_t)1 << log_n;
+      size_t outerIters = MSM_OUTER_ITERS(npoints);
+
+      for (size_t nthreads : thread_counts) {
+        MSMResult result;
+
+        msm_g1_pippenger(&out, points, input, npoints, nthreads);
+
+        for (size_t i = 0; i < outerIters; i++) {
+          perf.start_collection();
+          msm_g1_pippenger(&out, points, input, npoints, nthreads);
+          perf.end_collection(i);
+        }
+
+        result.equal          = eq != 0;
+        result.npoints        = npoints;
+        result.nthreads       = nthreads;
+        result.wbits          = msm_g1_window_size(npoints);
+        result.cycles_per_msm = perf.get_cycles_per_op(outerIters, 1);
+        result.nsecs_per_msm  = perf.get_nsecs_per_op(outerIters, 1);
+        results.push_back(result);
+      }
+    }
+  }
+
+  std::cout << "Benchmark            window     cyc/msm      ms/msm"
+            << "  ns/point   speedup" << std::endl;
+  std::cout << "_______________________________________________________"
+            << "____________________" << std::endl;
+  double single_thread_cycles = 0;
+  for (auto it = results.begin(); it != results.end(); ++it) {
+    std::string name = std::string(it->equal ? "MSMG1Eq/2^" : "MSMG1/2^")
+                     + std::to_string(__builtin_ctzll(it->npoints))
+                     + "/" + std::to_string(it->nthreads) + "thr";
+
+    if (it->nthreads == 1)
+      single_thread_cycles = it->cycles_per_msm;
+
+    std::cout << std::setw(20) << std::left  << name
+              << std::setw(7)  << std::right << it->wbits
+              << std::setprecision(0)
+              << std::setw(12) << std::right << it->cycles_per_msm
+              << std::setprecision(3)
+              << std::setw(12) << std::right << it->nsecs_per_msm / 1000000
+              << std::setprecision(1)
+              << std::setw(10) << std::right
+              << it->nsecs_per_msm / it->npoints
+              << std::setprecision(2)
+              << std::setw(10) << std::right
+              << single_thread_cycles / it->cycles_per_msm
+              << std::endl;
+  }
+
+  delete[] points;
+  delete[] scalars;
+  delete[] equal;
+
+  std::cout << std::endl;
+  auto endClock = std::chrono::system_clock::now();
+  std::chrono::duration<double> runTime = endClock - startClock;
+  std::cout << "Total runtime is: " << runTime.count() << " secs" << std::endl;
+
+  return 0;
+}
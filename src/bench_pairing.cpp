@@ -0,0 +1,184 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Prints results in format that benchstat can process
+//#define PRINT_GO_BENCHSTAT_FORMAT true
+#define PRINT_GO_BENCHSTAT_FORMAT false
+
+// Primitive costs are taken with serial dependence between calls, which is
+// how they are chained inside the pairing
+#define BENCH_ONLY_SERIAL_DEPENDENCE true
+
+#include <iostream>
+#include <iomanip>
+#include <locale>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <random>
+#include <cstring>
+
+#include "bench.h"
+#include "pairing.h"
+
+#ifndef EVM384_COUNT_OPS
+# error "bench_pairing needs the primitive counters, build with -DEVM384_COUNT_OPS"
+#endif
+
+// Outer iterations are number of bench runs to perform per function
+// Inner iterations are the number of times to run the function in a timed loop
+#define OUTER_ITERS_PAIRING 10
+#define INNER_ITERS_PAIRING 100
+
+BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384AddBLS381, add_mod_384,
+           dest, x, y, BLS12_381_P)
+
+BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384SubBLS381, sub_mod_384,
+           dest, x, y, BLS12_381_P)
+
+BENCH_FUNC(OUTER_ITERS_FAST, INNER_ITERS_FAST, EVM384MulBLS381, mul_mont_384,
+           dest, x, y, BLS12_381_P, BLS12_381_p0)
+
+void BenchMillerLoop(Perf* perf, std::vector<BenchResult>& results) {
+  vec384fp12 f;
+
+  WARM_UP_AND_BENCH(MillerLoop, , OUTER_ITERS_PAIRING, INNER_ITERS_PAIRING,
+                    miller_loop, f, &BLS12_381_G2, &BLS12_381_G1)
+}
+
+void BenchFinalExp(Perf* perf, std::vector<BenchResult>& results) {
+  vec384fp12 f;
+
+  miller_loop(f, &BLS12_381_G2, &BLS12_381_G1);
+
+  WARM_UP_AND_BENCH(FinalExp, , OUTER_ITERS_PAIRING, INNER_ITERS_PAIRING,
+                    final_exp, f, f)
+}
+
+void BenchPairing(Perf* perf, std::vector<BenchResult>& results) {
+  vec384fp12 f;
+
+  WARM_UP_AND_BENCH(Pairing, , OUTER_ITERS_PAIRING, INNER_ITERS_PAIRING,
+                    pairing, f, &BLS12_381_G1, &BLS12_381_G2)
+}
+
+// Primitive calls made by a single invocation of each stage
+static fp_op_counts_t count_ops(int stage) {
+  vec384fp12 f;
+
+  miller_loop(f, &BLS12_381_G2, &BLS12_381_G1);
+
+  memset(&fp_op_counts, 0, sizeof(fp_op_counts));
+  switch (stage) {
+    case 0:
+      miller_loop(f, &BLS12_381_G2, &BLS12_381_G1);
+      break;
+    case 1:
+      final_exp(f, f);
+      break;
+    default:
+      pairing(f, &BLS12_381_G1, &BLS12_381_G2);
+      break;
+  }
+
+  return fp_op_counts;
+}
+
+int main(int argc, char **argv) {
+  bool skip_cycle_check = false;
+  if (argc > 1) {
+    if (!strcmp("-skip-cycle-check", argv[1])) {
+      skip_cycle_check = true;
+    }
+  }
+
+  Perf perf(OUTER_ITERS_FAST, INNER_ITERS_FAST);
+
+  // Check for stable CPU clock frequency
+  uint64_t  cycles_per_sec = perf.get_cycles_per_sec();
+
+  if (cycles_per_sec == 0) {
+    if (skip_cycle_check) {
+      std::cout << "Unstable frequency!! Proceeding anyway" << std::endl;
+    } else {
+      std::cout << "Skipping benchmark runs - unstable frequency" << std::endl;
+      return -1;
+    }
+  }
+
+  std::cout.imbue(std::locale(""));
+  std::cout << "CPU cyc/sec: " << std::fixed << cycles_per_sec << std::endl;
+  std::cout.imbue(std::locale());
+  std::cout << std::endl;
+
+  std::uniform_int_distribution<uint64_t>
+    dist(0, std::numeric_limits<uint64_t>::max());
+
+  // RNG for last limb to ensure scalar < order
+  std::uniform_int_distribution<uint64_t>
+    dist_upper(0, BLS12_381_P[5]);
+
+  auto startClock = std::chrono::system_clock::now();
+  std::time_t startTime = std::chrono::system_clock::to_time_t(startClock);
+  std::cout << "Run date: " << std::ctime(&startTime) << std::endl;
+
+  std::vector<BenchResult> results;
+
+  BenchEVM384AddBLS381(&perf, dist, dist_upper, results);
+  BenchEVM384SubBLS381(&perf, dist, dist_upper, results);
+  BenchEVM384MulBLS381(&perf, dist, dist_upper, results);
+  BenchMillerLoop(&perf, results);
+  BenchFinalExp(&perf, results);
+  BenchPairing(&perf, results);
+
+  std::cout << "Benchmark                                   cyc/op     ns/op"
+            << std::endl;
+  std::cout << "____________________________________________________________"
+            << std::endl;
+  for (auto it = results.begin(); it != results.end(); ++it) {
+      std::cout << std::setw(40) << std::left  << (*it).name
+                << std::setprecision(1)
+                << std::setw(10) << std::right << (*it).cycles_per_op
+                << std::setw(10) << std::right << (*it).nsecs_per_op
+                << std::endl;
+  }
+
+  // Estimated cycles spent in each primitive, using the measured per-call
+  // cost of the serially dependent add, sub and mul benchmarks
+  double add_cyc = results[0].cycles_per_op;
+  double sub_cyc = results[1].cycles_per_op;
+  double mul_cyc = results[2].cycles_per_op;
+
+  std::cout << std::endl;
+  std::cout << "Breakdown by primitive" << std::endl;
+  std::cout << "Stage                add       sub       mul"
+            << "   add cyc   sub cyc   mul cyc   other cyc" << std::endl;
+  std::cout << "_____________________________________________"
+            << "________________________________________" << std::endl;
+  for (int stage = 0; stage < 3; stage++) {
+    fp_op_counts_t counts   = count_ops(stage);
+    double         measured = results[3 + stage].cycles_per_op;
+    double         adds     = counts.add * add_cyc;
+    double         subs     = counts.sub * sub_cyc;
+    double         muls     = counts.mul * mul_cyc;
+
+    std::cout << std::setw(14) << std::left << results[3 + stage].name
+              << std::setprecision(0)
+              << std::setw(10) << std::right << counts.add
+              << std::setw(10) << std::right << counts.sub
+              << std::setw(10) << std::right << counts.mul
+              << std::setw(10) << std::right << adds
+              << std::setw(10) << std::right << subs
+              << std::setw(10) << std::right << muls
+              << std::setw(12) << std::right << measured - adds - subs - muls
+              << std::endl;
+  }
+
+  std::cout << std::endl;
+  auto endClock = std::chrono::system_clock::now();
+  std::chrono::duration<double> runTime = endClock - startClock;
+  std::cout << "Total runtime is: " << runTime.count() << " secs" << std::endl;
+
+  return 0;
+}
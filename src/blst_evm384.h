@@ -18,6 +18,23 @@ extern "C" {
                     const vec384 p, uint64_t n0);
 }
 
+// Two independent Montgomery multiplications, ret[i] = a[i] * b[i], with the
+// instruction streams interleaved.  ret may be the same array as a or b.
+#if (defined(__x86_64) || defined(__x86_64__)) && defined(__ELF__) && \
+    defined(__BMI2__) && !defined(__BLST_PORTABLE__)
+extern "C" {
+  void mul_mont_384x2(vec384 ret[2], const vec384 a[2], const vec384 b[2],
+                      const vec384 p, uint64_t n0);
+}
+#else
+static inline void mul_mont_384x2(vec384 ret[2], const vec384 a[2],
+                                  const vec384 b[2], const vec384 p,
+                                  uint64_t n0) {
+  mul_mont_384(ret[0], a[0], b[0], p, n0);
+  mul_mont_384(ret[1], a[1], b[1], p, n0);
+}
+#endif
+
 // BLS12-381 Modulus
 const uint64_t BLS12_381_P[6] = {
     0xb9feffffffffaaab, 0x1eabfffeb153ffff,
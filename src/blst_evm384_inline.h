@@ -0,0 +1,106 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __BLST_EVM384_INLINE_H__
+#define __BLST_EVM384_INLINE_H__
+
+#include <cstdint>
+#include "blst_evm384.h"
+
+// Header-only constant time add/sub with the same signatures as
+// add_mod_384/sub_mod_384.  Being inlined, chains of them can keep operands
+// in registers and be scheduled together by the compiler.  The result is
+// selected with masks, never with a branch.  ret may alias a or b.
+
+#if defined(__x86_64) || defined(__x86_64__)
+# include <x86intrin.h>
+
+static inline void add_mod_384_inline(vec384 ret, const vec384 a,
+                                      const vec384 b, const vec384 p) {
+  unsigned long long tmp[6], red[6];
+  unsigned char      carry = 0, borrow = 0;
+  uint64_t           mask;
+
+  for (int i = 0; i < 6; i++)
+    carry = _addcarry_u64(carry, a[i], b[i], &tmp[i]);
+
+  for (int i = 0; i < 6; i++)
+    borrow = _subborrow_u64(borrow, tmp[i], p[i], &red[i]);
+
+  // Keep a + b only if it is below p and didn't carry out
+  mask = (uint64_t)carry - borrow;
+
+  for (int i = 0; i < 6; i++)
+    ret[i] = (red[i] & ~mask) | (tmp[i] & mask);
+}
+
+static inline void sub_mod_384_inline(vec384 ret, const vec384 a,
+                                      const vec384 b, const vec384 p) {
+  unsigned long long tmp[6], res[6];
+  unsigned char      carry = 0, borrow = 0;
+  uint64_t           mask;
+
+  for (int i = 0; i < 6; i++)
+    borrow = _subborrow_u64(borrow, a[i], b[i], &tmp[i]);
+
+  // Add p back if a - b borrowed
+  mask = 0 - (uint64_t)borrow;
+
+  for (int i = 0; i < 6; i++)
+    carry = _addcarry_u64(carry, tmp[i], p[i] & mask, &res[i]);
+
+  for (int i = 0; i < 6; i++)
+    ret[i] = res[i];
+}
+
+#else
+
+static inline void add_mod_384_inline(vec384 ret, const vec384 a,
+                                      const vec384 b, const vec384 p) {
+  __uint128_t limbx;
+  uint64_t    tmp[6], red[6], mask, carry, borrow;
+  int         i;
+
+  for (carry = 0, i = 0; i < 6; i++) {
+    limbx  = a[i] + (b[i] + (__uint128_t)carry);
+    tmp[i] = (uint64_t)limbx;
+    carry  = (uint64_t)(limbx >> 64);
+  }
+
+  for (borrow = 0, i = 0; i < 6; i++) {
+    limbx  = tmp[i] - (p[i] + (__uint128_t)borrow);
+    red[i] = (uint64_t)limbx;
+    borrow = (uint64_t)(limbx >> 64) & 1;
+  }
+
+  mask = carry - borrow;
+
+  for (i = 0; i < 6; i++)
+    ret[i] = (red[i] & ~mask) | (tmp[i] & mask);
+}
+
+static inline void sub_mod_384_inline(vec384 ret, const vec384 a,
+                                      const vec384 b, const vec384 p) {
+  __uint128_t limbx;
+  uint64_t    tmp[6], mask, carry, borrow;
+  int         i;
+
+  for (borrow = 0, i = 0; i < 6; i++) {
+    limbx  = a[i] - (b[i] + (__uint128_t)borrow);
+    tmp[i] = (uint64_t)limbx;
+    borrow = (uint64_t)(limbx >> 64) & 1;
+  }
+
+  mask = 0 - borrow;
+
+  for (carry = 0, i = 0; i < 6; i++) {
+    limbx  = tmp[i] + ((p[i] & mask) + (__uint128_t)carry);
+    ret[i] = (uint64_t)limbx;
+    carry  = (uint64_t)(limbx >> 64);
+  }
+}
+
+#endif
+
+#endif /* __BLST_EVM384_INLINE_H__ */
@@ -0,0 +1,66 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include "blst_evm384_vartime.h"
+
+// a >= p, deciding on the most significant differing limb
+static inline bool geq_384_vartime(const uint64_t a[6], const vec384 p) {
+  for (int i = 5; i >= 0; i--) {
+    if (a[i] != p[i])
+      return a[i] > p[i];
+  }
+  return true;
+}
+
+static inline void sub_p_384_vartime(vec384 ret, const uint64_t a[6],
+                                     const vec384 p) {
+  __uint128_t limbx;
+  uint64_t borrow;
+  std::size_t i;
+
+  for (borrow=0, i=0; i<6; i++) {
+    limbx = a[i] - (p[i] + (__uint128_t)borrow);
+    ret[i] = (uint64_t)limbx;
+    borrow = (uint64_t)(limbx >> 64) & 1;
+  }
+}
+
+void add_mod_384_vartime(vec384 ret, const vec384 a, const vec384 b,
+                         const vec384 p) {
+  __uint128_t limbx;
+  uint64_t carry;
+  std::size_t i;
+
+  for (carry=0, i=0; i<6; i++) {
+    limbx = a[i] + (b[i] + (__uint128_t)carry);
+    ret[i] = (uint64_t)limbx;
+    carry = (uint64_t)(limbx >> 64);
+  }
+
+  if (carry || geq_384_vartime(ret, p))
+    sub_p_384_vartime(ret, ret, p);
+}
+
+void sub_mod_384_vartime(vec384 ret, const vec384 a, const vec384 b,
+                         const vec384 p) {
+  __uint128_t limbx;
+  uint64_t carry, borrow;
+  std::size_t i;
+
+  for (borrow=0, i=0; i<6; i++) {
+    limbx = a[i] - (b[i] + (__uint128_t)borrow);
+    ret[i] = (uint64_t)limbx;
+    borrow = (uint64_t)(limbx >> 64) & 1;
+  }
+
+  if (!borrow)
+    return;
+
+  for (carry=0, i=0; i<6; i++) {
+    limbx = ret[i] + (p[i] + (__uint128_t)carry);
+    ret[i] = (uint64_t)limbx;
+    carry = (uint64_t)(limbx >> 64);
+  }
+}
@@ -0,0 +1,26 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __BLST_EVM384_VARTIME_H__
+#define __BLST_EVM384_VARTIME_H__
+
+#include <cstdint>
+#include "blst_evm384.h"
+
+// Variable time add/sub with the same signatures and results as
+// add_mod_384/sub_mod_384.  They branch on operand values: the reduction
+// is only done when it is needed and the limb compare against p exits
+// early.  Timing leaks the operands, so only use them on public data such
+// as signature verification inputs, never on secret keys or nonces.  ret
+// may alias a or b.
+//
+// There is no vartime mul: a portable C multiply can't beat the MULX/ADX
+// mul_mont_384, and skipping zero limbs never fires on field elements.
+
+void add_mod_384_vartime(vec384 ret, const vec384 a, const vec384 b,
+                         const vec384 p);
+void sub_mod_384_vartime(vec384 ret, const vec384 a, const vec384 b,
+                         const vec384 p);
+
+#endif /* __BLST_EVM384_VARTIME_H__ */
@@ -0,0 +1,228 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#define PRINT_GO_BENCHSTAT_FORMAT false
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+#include "bench.h"
+#include "blst_evm384.h"
+#include "calibrate.h"
+
+// Modulus widths in bits, 381 is the BLS12-381 modulus itself
+static const size_t calibrate_widths[] = { 64, 128, 192, 256, 320, 381 };
+
+#define CALIBRATE_NUM_WIDTHS \
+  (sizeof(calibrate_widths) / sizeof(calibrate_widths[0]))
+
+typedef void (*add_sub_func_t)(vec384, const vec384, const vec384,
+                               const vec384);
+typedef void (*mul_func_t)(vec384, const vec384, const vec384, const vec384,
+                           uint64_t);
+
+struct calibrate_modulus_t {
+  size_t   bits;
+  vec384   p;
+  uint64_t n0;
+};
+
+struct calibrate_kernel_t {
+  const char* kernel;
+  const char* impl;
+  bool        is_mul;
+};
+
+static const calibrate_kernel_t calibrate_kernels[] = {
+  { "add", "asm",    false },
+  { "add", "no_asm", false },
+  { "sub", "asm",    false },
+  { "sub", "no_asm", false },
+  { "mul", "asm",    true  },
+  { "mul", "no_asm", true  },
+};
+
+#define CALIBRATE_NUM_KERNELS \
+  (sizeof(calibrate_kernels) / sizeof(calibrate_kernels[0]))
+
+// -1 / p mod 2^64 by Newton iteration, p must be odd
+static uint64_t calibrate_n0(uint64_t p0) {
+  uint64_t inv = 1;
+
+  for (int i = 0; i < 6; i++)
+    inv *= 2 - p0 * inv;
+
+  return 0 - inv;
+}
+
+static void calibrate_modulus(calibrate_modulus_t* m, size_t bits,
+                              std::mt19937_64& gen) {
+  size_t top = (bits - 1) / 64;
+
+  m->bits = bits;
+  if (bits == 381) {
+    memcpy(m->p, BLS12_381_P, sizeof(vec384));
+  } else {
+    for (size_t i = 0; i < 6; i++)
+      m->p[i] = i <= top ? gen() : 0;
+    if (bits % 64)
+      m->p[top] &= ((uint64_t)1 << (bits % 64)) - 1;
+    m->p[top] |= (uint64_t)1 << ((bits - 1) % 64);
+    m->p[0]   |= 1;
+  }
+  m->n0 = calibrate_n0(m->p[0]);
+}
+
+// Random value below p
+static void calibrate_input(vec384 x, const calibrate_modulus_t* m,
+                            std::mt19937_64& gen) {
+  size_t top = (m->bits - 1) / 64;
+
+  for (size_t i = 0; i < 6; i++)
+    x[i] = i < top ? gen() : 0;
+  x[top] = gen() % m->p[top];
+}
+
+template <add_sub_func_t func>
+static BenchResult calibrate_add_sub(Perf* perf, const calibrate_modulus_t* m,
+                                     bool same, std::mt19937_64& gen) {
+  std::vector<BenchResult> results;
+  uint64_t  x[6];
+  uint64_t  y[6];
+  uint64_t  diff[6];
+  uint64_t* dest = same ? x : diff;
+
+  calibrate_input(x, m, gen);
+  calibrate_input(y, m, gen);
+
+  WARM_UP_AND_BENCH(Calibrate, , OUTER_ITERS_FAST, INNER_ITERS_FAST,
+                    func, dest, x, y, m->p)
+
+  return results[0];
+}
+
+template <mul_func_t func>
+static BenchResult calibrate_mul(Perf* perf, const calibrate_modulus_t* m,
+                                 bool same, std::mt19937_64& gen) {
+  std::vector<BenchResult> results;
+  uint64_t  x[6];
+  uint64_t  y[6];
+  uint64_t  diff[6];
+  uint64_t* dest = same ? x : diff;
+
+  calibrate_input(x, m, gen);
+  calibrate_input(y, m, gen);
+
+  WARM_UP_AND_BENCH(Calibrate, , OUTER_ITERS_FAST, INNER_ITERS_FAST,
+                    func, dest, x, y, m->p, m->n0)
+
+  return results[0];
+}
+
+static BenchResult calibrate_run(Perf* perf, size_t kernel,
+                                 const calibrate_modulus_t* m, bool same,
+                                 std::mt19937_64& gen) {
+  switch (kernel) {
+    case 0:  return calibrate_add_sub<add_mod_384>(perf, m, same, gen);
+    case 1:  return calibrate_add_sub<add_mod_384_no_asm>(perf, m, same, gen);
+    case 2:  return calibrate_add_sub<sub_mod_384>(perf, m, same, gen);
+    case 3:  return calibrate_add_sub<sub_mod_384_no_asm>(perf, m, same, gen);
+    case 4:  return calibrate_mul<mul_mont_384>(perf, m, same, gen);
+    default: return calibrate_mul<mul_mont_384_no_asm>(perf, m, same, gen);
+  }
+}
+
+// The kernels are fixed width 384-bit code, so their cost should not depend
+// on the modulus.  A sweep whose spread exceeds this fraction of the mean is
+// flagged as width dependent, i.e. too noisy to price from.
+#define CALIBRATE_FLAT_TOLERANCE 0.10
+
+void run_calibration(Perf* perf, uint64_t cycles_per_sec, double gas_per_sec,
+                     std::ostream& out) {
+  calibrate_modulus_t moduli[CALIBRATE_NUM_WIDTHS];
+  BenchResult         same[CALIBRATE_NUM_KERNELS][CALIBRATE_NUM_WIDTHS];
+  BenchResult         diff[CALIBRATE_NUM_KERNELS][CALIBRATE_NUM_WIDTHS];
+  double              mean[CALIBRATE_NUM_KERNELS];
+  double              lo[CALIBRATE_NUM_KERNELS], hi[CALIBRATE_NUM_KERNELS];
+  std::mt19937_64     gen(1);
+
+  for (size_t w = 0; w < CALIBRATE_NUM_WIDTHS; w++)
+    calibrate_modulus(&moduli[w], calibrate_widths[w], gen);
+
+  for (size_t k = 0; k < CALIBRATE_NUM_KERNELS; k++) {
+    mean[k] = 0;
+    lo[k]   = INFINITY;
+    hi[k]   = 0;
+
+    for (size_t w = 0; w < CALIBRATE_NUM_WIDTHS; w++) {
+      std::cerr << "Calibrating " << calibrate_kernels[k].kernel << " "
+                << calibrate_kernels[k].impl << " "
+                << moduli[w].bits << " bits" << std::endl;
+      same[k][w] = calibrate_run(perf, k, &moduli[w], true,  gen);
+      diff[k][w] = calibrate_run(perf, k, &moduli[w], false, gen);
+
+      // Gas follows the dependent (Same) latency, the proper per-op cost
+      double cycles = same[k][w].cycles_per_op;
+
+      mean[k] += cycles;
+      lo[k]    = std::min(lo[k], cycles);
+      hi[k]    = std::max(hi[k], cycles);
+    }
+    mean[k] /= CALIBRATE_NUM_WIDTHS;
+  }
+
+  // ns and gas are NAN if the frequency is unknown
+  double gas_per_cycle = cycles_per_sec != 0 ?
+                         gas_per_sec / cycles_per_sec : NAN;
+
+  // Gas is priced from each measurement itself, the deviation from the
+  // kernel mean shows whether the cost stays flat over the sweep
+  out << std::fixed;
+  out << "kernel,impl,bits,dependency,cycles_per_op,ns_per_op,"
+      << "deviation_from_mean_pct,suggested_gas" << std::endl;
+  for (size_t k = 0; k < CALIBRATE_NUM_KERNELS; k++) {
+    for (size_t w = 0; w < CALIBRATE_NUM_WIDTHS; w++) {
+      for (int d = 0; d < 2; d++) {
+        const BenchResult* r = d == 0 ? &same[k][w] : &diff[k][w];
+
+        out << calibrate_kernels[k].kernel << ","
+            << calibrate_kernels[k].impl << ","
+            << moduli[w].bits << ","
+            << (d == 0 ? "same" : "diff") << ","
+            << std::setprecision(1) << r->cycles_per_op << ","
+            << std::setprecision(2)
+            << (cycles_per_sec != 0 ? r->nsecs_per_op : NAN) << ","
+            << std::setprecision(1)
+            << (d == 0 ? 100.0 * (r->cycles_per_op - mean[k]) / mean[k]
+                       : NAN) << ","
+            << std::setprecision(3) << r->cycles_per_op * gas_per_cycle
+            << std::endl;
+      }
+    }
+  }
+
+  // One constant cost per kernel, the mean of the Same measurements
+  out << std::endl;
+  out << "kernel,impl,mean_cycles,min_cycles,max_cycles,spread_pct,"
+      << "width_check,suggested_gas,gas_per_sec" << std::endl;
+  for (size_t k = 0; k < CALIBRATE_NUM_KERNELS; k++) {
+    double spread = (hi[k] - lo[k]) / mean[k];
+
+    out << calibrate_kernels[k].kernel << ","
+        << calibrate_kernels[k].impl << ","
+        << std::setprecision(1) << mean[k] << ","
+        << std::setprecision(1) << lo[k] << ","
+        << std::setprecision(1) << hi[k] << ","
+        << std::setprecision(1) << 100.0 * spread << ","
+        << (spread <= CALIBRATE_FLAT_TOLERANCE ? "flat" : "width_dependent")
+        << ","
+        << std::setprecision(3) << mean[k] * gas_per_cycle << ","
+        << std::setprecision(0) << gas_per_sec << std::endl;
+  }
+}
@@ -0,0 +1,25 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_CALIBRATE_H__
+#define __SUPRANATIONAL_CALIBRATE_H__
+
+#include <cstdint>
+#include <ostream>
+#include "perf.h"
+
+// Gas per second of execution used to turn ns/op into gas, a typical target
+// rate for pricing precompiles
+#define CALIBRATE_GAS_PER_SEC 30000000
+
+// Measures every add/sub/mul kernel (asm and no asm) over a sweep of modulus
+// widths with dependent (Same) and independent (Diff) inputs and writes CSV
+// tables to out: gas for each measurement, then one constant cost per kernel
+// with a check that it stays flat across widths.  The kernels are fixed
+// width 384-bit code, so the sweep is a consistency check, not a model of
+// smaller moduli.  perf must hold at least OUTER_ITERS_FAST results.
+void run_calibration(Perf* perf, uint64_t cycles_per_sec, double gas_per_sec,
+                     std::ostream& out);
+
+#endif /* __SUPRANATIONAL_CALIBRATE_H__ */
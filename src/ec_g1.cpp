@@ -0,0 +1,266 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include "ec_g1.h"
+
+// Formulas from https://hyperelliptic.org/EFD/g1p/auto-shortw-jacobian-0.html
+// All routines tolerate out aliasing an input.
+
+bool POINTonE1_is_inf(const POINTonE1* in) {
+  return fp_is_zero(in->Z);
+}
+
+bool POINTonE1_affine_is_inf(const POINTonE1_affine* in) {
+  return fp_is_zero(in->X) && fp_is_zero(in->Y);
+}
+
+bool POINTonE1_affine_on_curve(const POINTonE1_affine* in) {
+  vec384 lhs, rhs;
+
+  fp_sqr(lhs, in->Y);
+  fp_sqr(rhs, in->X);
+  fp_mul(rhs, rhs, in->X);
+  fp_add(rhs, rhs, BLS12_381_B_G1);
+
+  return fp_is_equal(lhs, rhs);
+}
+
+void POINTonE1_from_affine(POINTonE1* out, const POINTonE1_affine* in) {
+  fp_copy(out->X, in->X);
+  fp_copy(out->Y, in->Y);
+  if (POINTonE1_affine_is_inf(in))
+    fp_copy(out->Z, ZERO_384);
+  else
+    fp_copy(out->Z, BLS12_381_ONE);
+}
+
+void POINTonE1_to_affine(POINTonE1_affine* out, const POINTonE1* in) {
+  vec384 zinv, zinv2;
+
+  if (POINTonE1_is_inf(in)) {
+    fp_copy(out->X, ZERO_384);
+    fp_copy(out->Y, ZERO_384);
+    return;
+  }
+
+  fp_inv(zinv, in->Z);
+  fp_sqr(zinv2, zinv);
+  fp_mul(out->X, in->X, zinv2);
+  fp_mul(zinv2, zinv2, zinv);
+  fp_mul(out->Y, in->Y, zinv2);
+}
+
+void POINTonE1_batch_to_affine(POINTonE1_affine out[], const POINTonE1 in[],
+                               size_t n) {
+  vec384* z       = new vec384[n];
+  vec384* scratch = new vec384[n];
+  vec384  zinv2;
+
+  for (size_t i = 0; i < n; i++)
+    fp_copy(z[i], in[i].Z);
+
+  fp_batch_inv(z, z, scratch, n);
+
+  for (size_t i = 0; i < n; i++) {
+    if (fp_is_zero(z[i])) {
+      fp_copy(out[i].X, ZERO_384);
+      fp_copy(out[i].Y, ZERO_384);
+      continue;
+    }
+    fp_sqr(zinv2, z[i]);
+    fp_mul(out[i].X, in[i].X, zinv2);
+    fp_mul(zinv2, zinv2, z[i]);
+    fp_mul(out[i].Y, in[i].Y, zinv2);
+  }
+
+  delete[] z;
+  delete[] scratch;
+}
+
+// dbl-2009-l
+void POINTonE1_double(POINTonE1* out, const POINTonE1* in) {
+  vec384 A, B, C, D, E, F, t;
+
+  fp_sqr(A, in->X);
+  fp_sqr(B, in->Y);
+  fp_sqr(C, B);
+
+  fp_add(D, in->X, B);
+  fp_sqr(D, D);
+  fp_sub(D, D, A);
+  fp_sub(D, D, C);
+  fp_add(D, D, D);
+
+  fp_add(E, A, A);
+  fp_add(E, E, A);
+  fp_sqr(F, E);
+
+  fp_mul(out->Z, in->Y, in->Z);
+  fp_add(out->Z, out->Z, out->Z);
+
+  fp_sub(F, F, D);
+  fp_sub(F, F, D);
+
+  fp_sub(t, D, F);
+  fp_mul(t, t, E);
+  fp_add(C, C, C);
+  fp_add(C, C, C);
+  fp_add(C, C, C);
+  fp_sub(out->Y, t, C);
+
+  fp_copy(out->X, F);
+}
+
+// add-2007-bl
+void POINTonE1_add(POINTonE1* out, const POINTonE1* a, const POINTonE1* b) {
+  vec384 Z1Z1, Z2Z2, U1, U2, S1, S2, H, I, J, r, V;
+
+  if (POINTonE1_is_inf(a)) {
+    *out = *b;
+    return;
+  }
+  if (POINTonE1_is_inf(b)) {
+    *out = *a;
+    return;
+  }
+
+  fp_sqr(Z1Z1, a->Z);
+  fp_sqr(Z2Z2, b->Z);
+  fp_mul(U1, a->X, Z2Z2);
+  fp_mul(U2, b->X, Z1Z1);
+  fp_mul(S1, a->Y, b->Z);
+  fp_mul(S1, S1, Z2Z2);
+  fp_mul(S2, b->Y, a->Z);
+  fp_mul(S2, S2, Z1Z1);
+
+  fp_sub(H, U2, U1);
+  fp_sub(r, S2, S1);
+
+  if (fp_is_zero(H)) {
+    if (fp_is_zero(r)) {
+      POINTonE1_double(out, a);
+    } else {
+      *out = POINTonE1_INF;
+    }
+    return;
+  }
+
+  fp_add(r, r, r);
+  fp_add(I, H, H);
+  fp_sqr(I, I);
+  fp_mul(J, H, I);
+  fp_mul(V, U1, I);
+
+  fp_add(out->Z, a->Z, b->Z);
+  fp_sqr(out->Z, out->Z);
+  fp_sub(out->Z, out->Z, Z1Z1);
+  fp_sub(out->Z, out->Z, Z2Z2);
+  fp_mul(out->Z, out->Z, H);
+
+  fp_sqr(out->X, r);
+  fp_sub(out->X, out->X, J);
+  fp_sub(out->X, out->X, V);
+  fp_sub(out->X, out->X, V);
+
+  fp_sub(V, V, out->X);
+  fp_mul(V, V, r);
+  fp_mul(S1, S1, J);
+  fp_add(S1, S1, S1);
+  fp_sub(out->Y, V, S1);
+}
+
+// madd-2007-bl
+void POINTonE1_add_affine(POINTonE1* out, const POINTonE1* a,
+                          const POINTonE1_affine* b) {
+  vec384 Z1Z1, U2, S2, H, HH, I, J, r, V, X1, Y1;
+
+  if (POINTonE1_affine_is_inf(b)) {
+    *out = *a;
+    return;
+  }
+  if (POINTonE1_is_inf(a)) {
+    POINTonE1_from_affine(out, b);
+    return;
+  }
+
+  fp_sqr(Z1Z1, a->Z);
+  fp_mul(U2, b->X, Z1Z1);
+  fp_mul(S2, b->Y, a->Z);
+  fp_mul(S2, S2, Z1Z1);
+
+  fp_sub(H, U2, a->X);
+  fp_sub(r, S2, a->Y);
+
+  if (fp_is_zero(H)) {
+    if (fp_is_zero(r)) {
+      POINTonE1_double(out, a);
+    } else {
+      *out = POINTonE1_INF;
+    }
+    return;
+  }
+
+  fp_copy(X1, a->X);
+  fp_copy(Y1, a->Y);
+
+  fp_sqr(HH, H);
+  fp_add(I, HH, HH);
+  fp_add(I, I, I);
+  fp_mul(J, H, I);
+  fp_add(r, r, r);
+  fp_mul(V, X1, I);
+
+  fp_add(out->Z, a->Z, H);
+  fp_sqr(out->Z, out->Z);
+  fp_sub(out->Z, out->Z, Z1Z1);
+  fp_sub(out->Z, out->Z, HH);
+
+  fp_sqr(out->X, r);
+  fp_sub(out->X, out->X, J);
+  fp_sub(out->X, out->X, V);
+  fp_sub(out->X, out->X, V);
+
+  fp_sub(V, V, out->X);
+  fp_mul(V, V, r);
+  fp_mul(Y1, Y1, J);
+  fp_add(Y1, Y1, Y1);
+  fp_sub(out->Y, V, Y1);
+}
+
+// Left-to-right double-and-add, used as a reference for the MSM
+void POINTonE1_mult(POINTonE1* out, const POINTonE1* in,
+                    const vec256 scalar, size_t nbits) {
+  POINTonE1 acc = POINTonE1_INF, base = *in;
+
+  for (size_t i = nbits; i-- > 0; ) {
+    POINTonE1_double(&acc, &acc);
+    if ((scalar[i / 64] >> (i % 64)) & 1)
+      POINTonE1_add(&acc, &acc, &base);
+  }
+
+  *out = acc;
+}
+
+bool POINTonE1_is_equal(const POINTonE1* a, const POINTonE1* b) {
+  vec384 Z1Z1, Z2Z2, t0, t1;
+  bool a_inf = POINTonE1_is_inf(a), b_inf = POINTonE1_is_inf(b);
+
+  if (a_inf || b_inf)
+    return a_inf == b_inf;
+
+  fp_sqr(Z1Z1, a->Z);
+  fp_sqr(Z2Z2, b->Z);
+
+  fp_mul(t0, a->X, Z2Z2);
+  fp_mul(t1, b->X, Z1Z1);
+  if (!fp_is_equal(t0, t1))
+    return false;
+
+  fp_mul(t0, a->Y, b->Z);
+  fp_mul(t0, t0, Z2Z2);
+  fp_mul(t1, b->Y, a->Z);
+  fp_mul(t1, t1, Z1Z1);
+  return fp_is_equal(t0, t1);
+}
@@ -0,0 +1,76 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_EC_G1_H__
+#define __SUPRANATIONAL_EC_G1_H__
+
+#include "fp.h"
+
+// BLS12-381 G1, y^2 = x^3 + 4 over Fp.  Coordinates are in Montgomery form.
+// Point at infinity is Z == 0 in Jacobian and (0, 0) in affine coordinates.
+// These routines branch on their inputs and are meant for public data only.
+
+typedef uint64_t vec256[4];
+
+struct POINTonE1 {
+  vec384 X, Y, Z;
+};
+
+struct POINTonE1_affine {
+  vec384 X, Y;
+};
+
+// Curve constant b = 4 in Montgomery form
+const uint64_t BLS12_381_B_G1[6] = {
+    0xaa270000000cfff3, 0x53cc0032fc34000a,
+    0x478fe97a6b0a807f, 0xb1d37ebee6ba24d7,
+    0x8ec9733bbf78ab2f, 0x09d645513d83de7e
+};
+
+// Generator in Montgomery form
+const POINTonE1_affine BLS12_381_G1 = {
+  { 0x5cb38790fd530c16, 0x7817fc679976fff5,
+    0x154f95c7143ba1c1, 0xf0ae6acdf3d0e747,
+    0xedce6ecc21dbf440, 0x120177419e0bfb75 },
+  { 0xbaac93d50ce72271, 0x8c22631a7918fd8e,
+    0xdd595f13570725ce, 0x51ac582950405194,
+    0x0e1c8c3fad0059c0, 0x0bbc3efc5008a26a }
+};
+
+const POINTonE1 POINTonE1_INF = {
+  { 0x760900000002fffd, 0xebf4000bc40c0002,
+    0x5f48985753c758ba, 0x77ce585370525745,
+    0x5c071a97a256ec6d, 0x15f65ec3fa80e493 },
+  { 0x760900000002fffd, 0xebf4000bc40c0002,
+    0x5f48985753c758ba, 0x77ce585370525745,
+    0x5c071a97a256ec6d, 0x15f65ec3fa80e493 },
+  { 0, 0, 0, 0, 0, 0 }
+};
+
+// Group order
+const uint64_t BLS12_381_r[4] = {
+    0xffffffff00000001, 0x53bda402fffe5bfe,
+    0x3339d80809a1d805, 0x73eda753299d7d48
+};
+
+#define BLS12_381_r_BITS 255
+
+void POINTonE1_from_affine(POINTonE1* out, const POINTonE1_affine* in);
+void POINTonE1_to_affine(POINTonE1_affine* out, const POINTonE1* in);
+void POINTonE1_batch_to_affine(POINTonE1_affine out[], const POINTonE1 in[],
+                               size_t n);
+
+void POINTonE1_double(POINTonE1* out, const POINTonE1* in);
+void POINTonE1_add(POINTonE1* out, const POINTonE1* a, const POINTonE1* b);
+void POINTonE1_add_affine(POINTonE1* out, const POINTonE1* a,
+                          const POINTonE1_affine* b);
+void POINTonE1_mult(POINTonE1* out, const POINTonE1* in,
+                    const vec256 scalar, size_t nbits);
+
+bool POINTonE1_is_inf(const POINTonE1* in);
+bool POINTonE1_is_equal(const POINTonE1* a, const POINTonE1* b);
+bool POINTonE1_affine_is_inf(const POINTonE1_affine* in);
+bool POINTonE1_affine_on_curve(const POINTonE1_affine* in);
+
+#endif /* __SUPRANATIONAL_EC_G1_H__ */
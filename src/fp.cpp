@@ -0,0 +1,90 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include "fp.h"
+
+// P - 2
+static const uint64_t BLS12_381_P_MINUS_2[6] = {
+    0xb9feffffffffaaa9, 0x1eabfffeb153ffff,
+    0x6730d2a0f6b0f624, 0x64774b84f38512bf,
+    0x4b1ba7b6434bacd7, 0x1a0111ea397fe69a
+};
+
+#ifdef EVM384_COUNT_OPS
+fp_op_counts_t fp_op_counts;
+#endif
+
+void fp_from_mont(vec384 ret, const vec384 a) {
+  static const uint64_t one[6] = { 1, 0, 0, 0, 0, 0 };
+
+  fp_mul(ret, a, one);
+}
+
+void fp_copy(vec384 ret, const vec384 a) {
+  for (std::size_t i = 0; i < 6; i++)
+    ret[i] = a[i];
+}
+
+bool fp_is_zero(const vec384 a) {
+  uint64_t acc = 0;
+
+  for (std::size_t i = 0; i < 6; i++)
+    acc |= a[i];
+
+  return acc == 0;
+}
+
+bool fp_is_equal(const vec384 a, const vec384 b) {
+  uint64_t acc = 0;
+
+  for (std::size_t i = 0; i < 6; i++)
+    acc |= a[i] ^ b[i];
+
+  return acc == 0;
+}
+
+void fp_inv(vec384 ret, const vec384 a) {
+  vec384 acc;
+  int i;
+
+  fp_copy(acc, a);
+
+  // Top bit of P - 2 is bit 380, consumed by the copy above
+  for (i = 379; i >= 0; i--) {
+    fp_sqr(acc, acc);
+    if ((BLS12_381_P_MINUS_2[i / 64] >> (i % 64)) & 1)
+      fp_mul(acc, acc, a);
+  }
+
+  fp_copy(ret, acc);
+}
+
+void fp_batch_inv(vec384 ret[], const vec384 a[], vec384 scratch[],
+                  size_t n) {
+  vec384 acc, inv, tmp;
+  size_t i;
+
+  fp_copy(acc, BLS12_381_ONE);
+  for (i = 0; i < n; i++) {
+    if (!fp_is_zero(a[i]))
+      fp_mul(acc, acc, a[i]);
+    fp_copy(scratch[i], acc);
+  }
+
+  fp_inv(inv, acc);
+
+  for (i = n; i-- > 0; ) {
+    if (fp_is_zero(a[i])) {
+      fp_copy(ret[i], ZERO_384);
+      continue;
+    }
+    fp_copy(tmp, a[i]);
+    if (i > 0)
+      fp_mul(ret[i], inv, scratch[i - 1]);
+    else
+      fp_copy(ret[i], inv);
+    fp_mul(inv, inv, tmp);
+  }
+}
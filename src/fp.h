@@ -0,0 +1,101 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_FP_H__
+#define __SUPRANATIONAL_FP_H__
+
+#include <cstdint>
+#include <cstddef>
+#include "blst_evm384.h"
+
+// BLS12-381 base field arithmetic built on the EVM384 primitives.
+// All values are kept in Montgomery form, R = 2^384 mod P.
+
+// R mod P, i.e. one in Montgomery form
+const uint64_t BLS12_381_ONE[6] = {
+    0x760900000002fffd, 0xebf4000bc40c0002,
+    0x5f48985753c758ba, 0x77ce585370525745,
+    0x5c071a97a256ec6d, 0x15f65ec3fa80e493
+};
+
+// R^2 mod P, used to convert into Montgomery form
+const uint64_t BLS12_381_RR[6] = {
+    0xf4df1f341c341746, 0x0a76e6a609d104f1,
+    0x8de5476c4c95b6d5, 0x67eb88a9939d83c0,
+    0x9a793e85b519952d, 0x11988fe592cae3aa
+};
+
+const uint64_t ZERO_384[6] = { 0, 0, 0, 0, 0, 0 };
+
+// Define EVM384_COUNT_OPS to count primitive calls made through this layer,
+// e.g. for cost breakdowns.  The counters are not thread safe.
+#ifdef EVM384_COUNT_OPS
+struct fp_op_counts_t {
+  uint64_t add;
+  uint64_t sub;
+  uint64_t mul;
+};
+
+extern fp_op_counts_t fp_op_counts;
+# define FP_COUNT_OP(op) (fp_op_counts.op++)
+#else
+# define FP_COUNT_OP(op)
+#endif
+
+// Define EVM384_TRACE_OPS to route the primitives through the trace.h
+// recording shim
+#ifdef EVM384_TRACE_OPS
+# include "trace.h"
+# define FP_ADD_MOD_384  trace_add_mod_384
+# define FP_SUB_MOD_384  trace_sub_mod_384
+# define FP_MUL_MONT_384 trace_mul_mont_384
+#else
+# define FP_ADD_MOD_384  add_mod_384
+# define FP_SUB_MOD_384  sub_mod_384
+# define FP_MUL_MONT_384 mul_mont_384
+#endif
+
+static inline void fp_add(vec384 ret, const vec384 a, const vec384 b) {
+  FP_COUNT_OP(add);
+  FP_ADD_MOD_384(ret, a, b, BLS12_381_P);
+}
+
+static inline void fp_sub(vec384 ret, const vec384 a, const vec384 b) {
+  FP_COUNT_OP(sub);
+  FP_SUB_MOD_384(ret, a, b, BLS12_381_P);
+}
+
+static inline void fp_mul(vec384 ret, const vec384 a, const vec384 b) {
+  FP_COUNT_OP(mul);
+  FP_MUL_MONT_384(ret, a, b, BLS12_381_P, BLS12_381_p0);
+}
+
+static inline void fp_sqr(vec384 ret, const vec384 a) {
+  FP_COUNT_OP(mul);
+  FP_MUL_MONT_384(ret, a, a, BLS12_381_P, BLS12_381_p0);
+}
+
+static inline void fp_neg(vec384 ret, const vec384 a) {
+  FP_COUNT_OP(sub);
+  FP_SUB_MOD_384(ret, ZERO_384, a, BLS12_381_P);
+}
+
+static inline void fp_to_mont(vec384 ret, const vec384 a) {
+  FP_COUNT_OP(mul);
+  FP_MUL_MONT_384(ret, a, BLS12_381_RR, BLS12_381_P, BLS12_381_p0);
+}
+
+void fp_from_mont(vec384 ret, const vec384 a);
+void fp_copy(vec384 ret, const vec384 a);
+bool fp_is_zero(const vec384 a);
+bool fp_is_equal(const vec384 a, const vec384 b);
+
+// Fermat inversion, a^(P-2).  Variable time only in the public exponent.
+void fp_inv(vec384 ret, const vec384 a);
+
+// Montgomery's trick, one fp_inv for n elements.  Zero inputs stay zero.
+// scratch must hold n elements and may not alias ret or a.
+void fp_batch_inv(vec384 ret[], const vec384 a[], vec384 scratch[], size_t n);
+
+#endif /* __SUPRANATIONAL_FP_H__ */
@@ -0,0 +1,476 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include "fp12.h"
+
+// Frobenius coefficients in Montgomery form, xi = u + 1
+// (u + 1)^((p - 1) / 3), pure imaginary
+static const uint64_t FROB6_C1[6] = {
+    0xcd03c9e48671f071, 0x5dab22461fcda5d2,
+    0x587042afd3851b95, 0x8eb60ebe01bacb9e,
+    0x03f97d6e83d050d2, 0x18f0206554638741
+};
+
+// (u + 1)^((2p - 2) / 3), pure real
+static const uint64_t FROB6_C2[6] = {
+    0x890dc9e4867545c3, 0x2af322533285a5d5,
+    0x50880866309b7e2c, 0xa20d1b8c7e881024,
+    0x14e4f04fe2db9068, 0x14e56d3f1564853a
+};
+
+// (u + 1)^((p - 1) / 6)
+static const vec384x FROB12_C1 = {
+  { 0x07089552b319d465, 0xc6695f92b50a8313,
+    0x97e83cccd117228f, 0xa35baecab2dc29ee,
+    0x1ce393ea5daace4d, 0x08f2220fb0fb66eb },
+  { 0xb2f66aad4ce5d646, 0x5842a06bfc497cec,
+    0xcf4895d42599d394, 0xc11b9cba40a8e8d0,
+    0x2e3813cbe5a0de89, 0x110eefda88847faf }
+};
+
+/*
+ * Fp2
+ */
+void fp2_add(vec384x ret, const vec384x a, const vec384x b) {
+  fp_add(ret[0], a[0], b[0]);
+  fp_add(ret[1], a[1], b[1]);
+}
+
+void fp2_sub(vec384x ret, const vec384x a, const vec384x b) {
+  fp_sub(ret[0], a[0], b[0]);
+  fp_sub(ret[1], a[1], b[1]);
+}
+
+void fp2_neg(vec384x ret, const vec384x a) {
+  fp_neg(ret[0], a[0]);
+  fp_neg(ret[1], a[1]);
+}
+
+void fp2_mul(vec384x ret, const vec384x a, const vec384x b) {
+  vec384 aa, bb, t0, t1;
+
+  fp_mul(aa, a[0], b[0]);
+  fp_mul(bb, a[1], b[1]);
+  fp_add(t0, a[0], a[1]);
+  fp_add(t1, b[0], b[1]);
+  fp_mul(t0, t0, t1);
+  fp_sub(t0, t0, aa);
+  fp_sub(ret[1], t0, bb);
+  fp_sub(ret[0], aa, bb);
+}
+
+void fp2_sqr(vec384x ret, const vec384x a) {
+  vec384 t0, t1, t2;
+
+  fp_add(t0, a[0], a[1]);
+  fp_sub(t1, a[0], a[1]);
+  fp_mul(t2, a[0], a[1]);
+  fp_mul(ret[0], t0, t1);
+  fp_add(ret[1], t2, t2);
+}
+
+void fp2_mul_by_fp(vec384x ret, const vec384x a, const vec384 b) {
+  fp_mul(ret[0], a[0], b);
+  fp_mul(ret[1], a[1], b);
+}
+
+// Multiply by u + 1
+void fp2_mul_by_nonresidue(vec384x ret, const vec384x a) {
+  vec384 t0;
+
+  fp_sub(t0, a[0], a[1]);
+  fp_add(ret[1], a[0], a[1]);
+  fp_copy(ret[0], t0);
+}
+
+void fp2_inv(vec384x ret, const vec384x a) {
+  vec384 t0, t1;
+
+  fp_sqr(t0, a[0]);
+  fp_sqr(t1, a[1]);
+  fp_add(t0, t0, t1);
+  fp_inv(t0, t0);
+  fp_mul(ret[0], a[0], t0);
+  fp_mul(t0, a[1], t0);
+  fp_neg(ret[1], t0);
+}
+
+void fp2_copy(vec384x ret, const vec384x a) {
+  fp_copy(ret[0], a[0]);
+  fp_copy(ret[1], a[1]);
+}
+
+bool fp2_is_zero(const vec384x a) {
+  return fp_is_zero(a[0]) && fp_is_zero(a[1]);
+}
+
+bool fp2_is_equal(const vec384x a, const vec384x b) {
+  return fp_is_equal(a[0], b[0]) && fp_is_equal(a[1], b[1]);
+}
+
+/*
+ * Fp6
+ */
+void fp6_add(vec384fp6 ret, const vec384fp6 a, const vec384fp6 b) {
+  fp2_add(ret[0], a[0], b[0]);
+  fp2_add(ret[1], a[1], b[1]);
+  fp2_add(ret[2], a[2], b[2]);
+}
+
+void fp6_sub(vec384fp6 ret, const vec384fp6 a, const vec384fp6 b) {
+  fp2_sub(ret[0], a[0], b[0]);
+  fp2_sub(ret[1], a[1], b[1]);
+  fp2_sub(ret[2], a[2], b[2]);
+}
+
+void fp6_neg(vec384fp6 ret, const vec384fp6 a) {
+  fp2_neg(ret[0], a[0]);
+  fp2_neg(ret[1], a[1]);
+  fp2_neg(ret[2], a[2]);
+}
+
+void fp6_copy(vec384fp6 ret, const vec384fp6 a) {
+  fp2_copy(ret[0], a[0]);
+  fp2_copy(ret[1], a[1]);
+  fp2_copy(ret[2], a[2]);
+}
+
+// Karatsuba
+void fp6_mul(vec384fp6 ret, const vec384fp6 a, const vec384fp6 b) {
+  vec384x aa, bb, cc, s0, s1, t0, t1, t2;
+
+  fp2_mul(aa, a[0], b[0]);
+  fp2_mul(bb, a[1], b[1]);
+  fp2_mul(cc, a[2], b[2]);
+
+  // t0 = ((a1 + a2)(b1 + b2) - bb - cc) * xi + aa
+  fp2_add(s0, a[1], a[2]);
+  fp2_add(s1, b[1], b[2]);
+  fp2_mul(t0, s0, s1);
+  fp2_sub(t0, t0, bb);
+  fp2_sub(t0, t0, cc);
+  fp2_mul_by_nonresidue(t0, t0);
+  fp2_add(t0, t0, aa);
+
+  // t1 = (a0 + a1)(b0 + b1) - aa - bb + cc * xi
+  fp2_add(s0, a[0], a[1]);
+  fp2_add(s1, b[0], b[1]);
+  fp2_mul(t1, s0, s1);
+  fp2_sub(t1, t1, aa);
+  fp2_sub(t1, t1, bb);
+  fp2_mul_by_nonresidue(s0, cc);
+  fp2_add(t1, t1, s0);
+
+  // t2 = (a0 + a2)(b0 + b2) - aa + bb - cc
+  fp2_add(s0, a[0], a[2]);
+  fp2_add(s1, b[0], b[2]);
+  fp2_mul(t2, s0, s1);
+  fp2_sub(t2, t2, aa);
+  fp2_add(t2, t2, bb);
+  fp2_sub(t2, t2, cc);
+
+  fp2_copy(ret[0], t0);
+  fp2_copy(ret[1], t1);
+  fp2_copy(ret[2], t2);
+}
+
+// Chung-Hasan SQR2
+void fp6_sqr(vec384fp6 ret, const vec384fp6 a) {
+  vec384x s0, s1, s2, s3, s4;
+
+  fp2_sqr(s0, a[0]);
+  fp2_mul(s1, a[0], a[1]);
+  fp2_add(s1, s1, s1);
+  fp2_sub(s2, a[0], a[1]);
+  fp2_add(s2, s2, a[2]);
+  fp2_sqr(s2, s2);
+  fp2_mul(s3, a[1], a[2]);
+  fp2_add(s3, s3, s3);
+  fp2_sqr(s4, a[2]);
+
+  // ret2 = s1 + s2 + s3 - s0 - s4
+  fp2_add(ret[2], s1, s2);
+  fp2_add(ret[2], ret[2], s3);
+  fp2_sub(ret[2], ret[2], s0);
+  fp2_sub(ret[2], ret[2], s4);
+
+  fp2_mul_by_nonresidue(s3, s3);
+  fp2_add(ret[0], s3, s0);
+  fp2_mul_by_nonresidue(s4, s4);
+  fp2_add(ret[1], s4, s1);
+}
+
+void fp6_mul_by_01(vec384fp6 ret, const vec384fp6 a,
+                   const vec384x b0, const vec384x b1) {
+  vec384x aa, bb, s0, s1, t0, t1, t2;
+
+  fp2_mul(aa, a[0], b0);
+  fp2_mul(bb, a[1], b1);
+
+  fp2_mul(t0, a[2], b1);
+  fp2_mul_by_nonresidue(t0, t0);
+  fp2_add(t0, t0, aa);
+
+  fp2_add(s0, b0, b1);
+  fp2_add(s1, a[0], a[1]);
+  fp2_mul(t1, s0, s1);
+  fp2_sub(t1, t1, aa);
+  fp2_sub(t1, t1, bb);
+
+  fp2_mul(t2, a[2], b0);
+  fp2_add(t2, t2, bb);
+
+  fp2_copy(ret[0], t0);
+  fp2_copy(ret[1], t1);
+  fp2_copy(ret[2], t2);
+}
+
+void fp6_mul_by_1(vec384fp6 ret, const vec384fp6 a, const vec384x b1) {
+  vec384x t0, t1, t2;
+
+  fp2_mul(t0, a[2], b1);
+  fp2_mul_by_nonresidue(t0, t0);
+  fp2_mul(t1, a[0], b1);
+  fp2_mul(t2, a[1], b1);
+
+  fp2_copy(ret[0], t0);
+  fp2_copy(ret[1], t1);
+  fp2_copy(ret[2], t2);
+}
+
+// Multiply by v
+void fp6_mul_by_nonresidue(vec384fp6 ret, const vec384fp6 a) {
+  vec384x t0;
+
+  fp2_mul_by_nonresidue(t0, a[2]);
+  fp2_copy(ret[2], a[1]);
+  fp2_copy(ret[1], a[0]);
+  fp2_copy(ret[0], t0);
+}
+
+void fp6_inv(vec384fp6 ret, const vec384fp6 a) {
+  vec384x c0, c1, c2, t0, t1;
+
+  // c0 = a0^2 - (a1 * a2) * xi
+  fp2_mul(t0, a[1], a[2]);
+  fp2_mul_by_nonresidue(t0, t0);
+  fp2_sqr(c0, a[0]);
+  fp2_sub(c0, c0, t0);
+
+  // c1 = a2^2 * xi - a0 * a1
+  fp2_sqr(c1, a[2]);
+  fp2_mul_by_nonresidue(c1, c1);
+  fp2_mul(t0, a[0], a[1]);
+  fp2_sub(c1, c1, t0);
+
+  // c2 = a1^2 - a0 * a2
+  fp2_sqr(c2, a[1]);
+  fp2_mul(t0, a[0], a[2]);
+  fp2_sub(c2, c2, t0);
+
+  // t0 = 1 / ((a1 * c2 + a2 * c1) * xi + a0 * c0)
+  fp2_mul(t0, a[1], c2);
+  fp2_mul(t1, a[2], c1);
+  fp2_add(t0, t0, t1);
+  fp2_mul_by_nonresidue(t0, t0);
+  fp2_mul(t1, a[0], c0);
+  fp2_add(t0, t0, t1);
+  fp2_inv(t0, t0);
+
+  fp2_mul(ret[0], c0, t0);
+  fp2_mul(ret[1], c1, t0);
+  fp2_mul(ret[2], c2, t0);
+}
+
+void fp6_frobenius(vec384fp6 ret, const vec384fp6 a) {
+  vec384x t;
+
+  // Frobenius on Fp2 is conjugation
+  fp_copy(ret[0][0], a[0][0]);
+  fp_neg(ret[0][1], a[0][1]);
+
+  // a1 * (u + 1)^((p - 1) / 3) where the coefficient is c * u
+  fp_mul(t[1], a[1][0], FROB6_C1);
+  fp_mul(t[0], a[1][1], FROB6_C1);
+  fp2_copy(ret[1], t);
+
+  fp_neg(t[1], a[2][1]);
+  fp_copy(t[0], a[2][0]);
+  fp2_mul_by_fp(ret[2], t, FROB6_C2);
+}
+
+/*
+ * Fp12
+ */
+void fp12_one(vec384fp12 ret) {
+  for (std::size_t i = 0; i < 2; i++)
+    for (std::size_t j = 0; j < 3; j++)
+      for (std::size_t k = 0; k < 2; k++)
+        fp_copy(ret[i][j][k], ZERO_384);
+  fp_copy(ret[0][0][0], BLS12_381_ONE);
+}
+
+void fp12_copy(vec384fp12 ret, const vec384fp12 a) {
+  fp6_copy(ret[0], a[0]);
+  fp6_copy(ret[1], a[1]);
+}
+
+bool fp12_is_equal(const vec384fp12 a, const vec384fp12 b) {
+  bool equal = true;
+
+  for (std::size_t i = 0; i < 2; i++)
+    for (std::size_t j = 0; j < 3; j++)
+      equal &= fp2_is_equal(a[i][j], b[i][j]);
+
+  return equal;
+}
+
+bool fp12_is_one(const vec384fp12 a) {
+  vec384fp12 one;
+
+  fp12_one(one);
+  return fp12_is_equal(a, one);
+}
+
+void fp12_mul(vec384fp12 ret, const vec384fp12 a, const vec384fp12 b) {
+  vec384fp6 aa, bb, t0, t1;
+
+  fp6_mul(aa, a[0], b[0]);
+  fp6_mul(bb, a[1], b[1]);
+
+  fp6_add(t0, a[0], a[1]);
+  fp6_add(t1, b[0], b[1]);
+  fp6_mul(t0, t0, t1);
+  fp6_sub(t0, t0, aa);
+  fp6_sub(ret[1], t0, bb);
+
+  fp6_mul_by_nonresidue(bb, bb);
+  fp6_add(ret[0], aa, bb);
+}
+
+void fp12_sqr(vec384fp12 ret, const vec384fp12 a) {
+  vec384fp6 ab, t0, t1;
+
+  fp6_mul(ab, a[0], a[1]);
+
+  // (a0 + a1)(a0 + a1 * v) - ab - ab * v
+  fp6_add(t0, a[0], a[1]);
+  fp6_mul_by_nonresidue(t1, a[1]);
+  fp6_add(t1, t1, a[0]);
+  fp6_mul(t0, t0, t1);
+  fp6_sub(t0, t0, ab);
+  fp6_mul_by_nonresidue(t1, ab);
+  fp6_sub(ret[0], t0, t1);
+
+  fp6_add(ret[1], ab, ab);
+}
+
+void fp12_inv(vec384fp12 ret, const vec384fp12 a) {
+  vec384fp6 t0, t1;
+
+  fp6_sqr(t0, a[0]);
+  fp6_sqr(t1, a[1]);
+  fp6_mul_by_nonresidue(t1, t1);
+  fp6_sub(t0, t0, t1);
+  fp6_inv(t0, t0);
+
+  fp6_mul(ret[0], a[0], t0);
+  fp6_mul(t1, a[1], t0);
+  fp6_neg(ret[1], t1);
+}
+
+void fp12_conjugate(vec384fp12 ret, const vec384fp12 a) {
+  fp6_copy(ret[0], a[0]);
+  fp6_neg(ret[1], a[1]);
+}
+
+void fp12_frobenius(vec384fp12 ret, const vec384fp12 a) {
+  fp6_frobenius(ret[0], a[0]);
+  fp6_frobenius(ret[1], a[1]);
+
+  fp2_mul(ret[1][0], ret[1][0], FROB12_C1);
+  fp2_mul(ret[1][1], ret[1][1], FROB12_C1);
+  fp2_mul(ret[1][2], ret[1][2], FROB12_C1);
+}
+
+void fp12_mul_by_014(vec384fp12 ret, const vec384fp12 a, const vec384x c0,
+                     const vec384x c1, const vec384x c4) {
+  vec384fp6 aa, bb, t0;
+  vec384x   s0;
+
+  fp6_mul_by_01(aa, a[0], c0, c1);
+  fp6_mul_by_1(bb, a[1], c4);
+
+  fp2_add(s0, c1, c4);
+  fp6_add(t0, a[0], a[1]);
+  fp6_mul_by_01(t0, t0, c0, s0);
+  fp6_sub(t0, t0, aa);
+  fp6_sub(ret[1], t0, bb);
+
+  fp6_mul_by_nonresidue(bb, bb);
+  fp6_add(ret[0], bb, aa);
+}
+
+// (a + b * w^3)^2 in Fp4 = Fp2[w^3] / (w^6 - xi)
+static void fp4_sqr(vec384x c0, vec384x c1, const vec384x a,
+                    const vec384x b) {
+  vec384x t0, t1, t2;
+
+  fp2_sqr(t0, a);
+  fp2_sqr(t1, b);
+  fp2_add(t2, a, b);
+  fp2_sqr(t2, t2);
+  fp2_sub(t2, t2, t0);
+  fp2_sub(c1, t2, t1);
+  fp2_mul_by_nonresidue(t1, t1);
+  fp2_add(c0, t1, t0);
+}
+
+// https://eprint.iacr.org/2009/565.pdf
+void fp12_cyclotomic_sqr(vec384fp12 ret, const vec384fp12 a) {
+  vec384x z0, z1, z2, z3, z4, z5, t0, t1, t2, t3;
+
+  fp2_copy(z0, a[0][0]);
+  fp2_copy(z4, a[0][1]);
+  fp2_copy(z3, a[0][2]);
+  fp2_copy(z2, a[1][0]);
+  fp2_copy(z1, a[1][1]);
+  fp2_copy(z5, a[1][2]);
+
+  // A
+  fp4_sqr(t0, t1, z0, z1);
+  fp2_sub(z0, t0, z0);
+  fp2_add(z0, z0, z0);
+  fp2_add(z0, z0, t0);
+  fp2_add(z1, t1, z1);
+  fp2_add(z1, z1, z1);
+  fp2_add(z1, z1, t1);
+
+  // C
+  fp4_sqr(t0, t1, z2, z3);
+  fp4_sqr(t2, t3, z4, z5);
+  fp2_sub(z4, t0, z4);
+  fp2_add(z4, z4, z4);
+  fp2_add(z4, z4, t0);
+  fp2_add(z5, t1, z5);
+  fp2_add(z5, z5, z5);
+  fp2_add(z5, z5, t1);
+
+  // B
+  fp2_mul_by_nonresidue(t0, t3);
+  fp2_add(z2, t0, z2);
+  fp2_add(z2, z2, z2);
+  fp2_add(z2, z2, t0);
+  fp2_sub(z3, t2, z3);
+  fp2_add(z3, z3, z3);
+  fp2_add(z3, z3, t2);
+
+  fp2_copy(ret[0][0], z0);
+  fp2_copy(ret[0][1], z4);
+  fp2_copy(ret[0][2], z3);
+  fp2_copy(ret[1][0], z2);
+  fp2_copy(ret[1][1], z1);
+  fp2_copy(ret[1][2], z5);
+}
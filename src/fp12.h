@@ -0,0 +1,63 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_FP12_H__
+#define __SUPRANATIONAL_FP12_H__
+
+#include "fp.h"
+
+// BLS12-381 extension tower over the Fp layer
+//   Fp2  = Fp[u]  / (u^2 + 1)
+//   Fp6  = Fp2[v] / (v^3 - (u + 1))
+//   Fp12 = Fp6[w] / (w^2 - v)
+// All routines tolerate ret aliasing an input.
+
+typedef vec384    vec384x[2];
+typedef vec384x   vec384fp6[3];
+typedef vec384fp6 vec384fp12[2];
+
+void fp2_add(vec384x ret, const vec384x a, const vec384x b);
+void fp2_sub(vec384x ret, const vec384x a, const vec384x b);
+void fp2_neg(vec384x ret, const vec384x a);
+void fp2_mul(vec384x ret, const vec384x a, const vec384x b);
+void fp2_sqr(vec384x ret, const vec384x a);
+void fp2_mul_by_fp(vec384x ret, const vec384x a, const vec384 b);
+void fp2_mul_by_nonresidue(vec384x ret, const vec384x a);
+void fp2_inv(vec384x ret, const vec384x a);
+void fp2_copy(vec384x ret, const vec384x a);
+bool fp2_is_zero(const vec384x a);
+bool fp2_is_equal(const vec384x a, const vec384x b);
+
+void fp6_add(vec384fp6 ret, const vec384fp6 a, const vec384fp6 b);
+void fp6_sub(vec384fp6 ret, const vec384fp6 a, const vec384fp6 b);
+void fp6_neg(vec384fp6 ret, const vec384fp6 a);
+void fp6_mul(vec384fp6 ret, const vec384fp6 a, const vec384fp6 b);
+void fp6_sqr(vec384fp6 ret, const vec384fp6 a);
+void fp6_mul_by_01(vec384fp6 ret, const vec384fp6 a,
+                   const vec384x b0, const vec384x b1);
+void fp6_mul_by_1(vec384fp6 ret, const vec384fp6 a, const vec384x b1);
+void fp6_mul_by_nonresidue(vec384fp6 ret, const vec384fp6 a);
+void fp6_inv(vec384fp6 ret, const vec384fp6 a);
+void fp6_frobenius(vec384fp6 ret, const vec384fp6 a);
+void fp6_copy(vec384fp6 ret, const vec384fp6 a);
+
+void fp12_one(vec384fp12 ret);
+void fp12_copy(vec384fp12 ret, const vec384fp12 a);
+bool fp12_is_one(const vec384fp12 a);
+bool fp12_is_equal(const vec384fp12 a, const vec384fp12 b);
+void fp12_mul(vec384fp12 ret, const vec384fp12 a, const vec384fp12 b);
+void fp12_sqr(vec384fp12 ret, const vec384fp12 a);
+void fp12_inv(vec384fp12 ret, const vec384fp12 a);
+void fp12_conjugate(vec384fp12 ret, const vec384fp12 a);
+void fp12_frobenius(vec384fp12 ret, const vec384fp12 a);
+
+// Multiply by the sparse element c0 + c1*v + c4*v*w, which is the shape
+// of a line evaluation in the Miller loop
+void fp12_mul_by_014(vec384fp12 ret, const vec384fp12 a, const vec384x c0,
+                     const vec384x c1, const vec384x c4);
+
+// Granger-Scott squaring, valid only in the cyclotomic subgroup
+void fp12_cyclotomic_sqr(vec384fp12 ret, const vec384fp12 a);
+
+#endif /* __SUPRANATIONAL_FP12_H__ */
@@ -0,0 +1,294 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "msm_g1.h"
+
+// Number of pending affine bucket additions sharing one inversion
+#define MSM_BATCH_SIZE 512
+
+// Below this window size there are too few buckets for a batch to amortize
+// the inversion, so buckets are accumulated in Jacobian coordinates instead
+#define MSM_BATCH_AFFINE_MIN_WBITS 10
+
+// Minimum points per chunk when splitting a window across threads
+#define MSM_MIN_CHUNK  1024
+
+enum bucket_state_t : uint8_t {
+  BUCKET_EMPTY = 0,
+  BUCKET_SET,
+  BUCKET_BUSY   // has an addition pending in the current batch
+};
+
+// Further points for a bucket that is busy in the current batch go to a
+// Jacobian overflow bucket, so repeated buckets such as equal scalars cost
+// a mixed addition each rather than a batch inversion each
+enum overflow_state_t : uint8_t {
+  OVERFLOW_EMPTY = 0,
+  OVERFLOW_SET
+};
+
+struct msm_scratch_t {
+  std::vector<POINTonE1>               jbuckets;
+  std::vector<POINTonE1_affine>        buckets;
+  std::vector<uint8_t>                 state;
+  std::vector<uint8_t>                 overflow;
+  std::vector<uint32_t>                batch_bucket;
+  std::vector<const POINTonE1_affine*> batch_point;
+  vec384*                              denom;
+  vec384*                              scratch;
+  size_t                               batch_len;
+};
+
+size_t msm_g1_window_size(size_t npoints) {
+  size_t wbits;
+
+  for (wbits = 0; (npoints >> wbits) > 1; wbits++) ;
+
+  return wbits > 13 ? wbits - 4 : (wbits > 5 ? wbits - 3 : 2);
+}
+
+static uint64_t get_wval(const vec256 scalar, size_t off, size_t bits) {
+  size_t   limb  = off / 64;
+  size_t   shift = off % 64;
+  uint64_t wval  = scalar[limb] >> shift;
+
+  if (shift + bits > 64 && limb < 3)
+    wval |= scalar[limb + 1] << (64 - shift);
+
+  return wval & ((1ULL << bits) - 1);
+}
+
+// Complete every pending bucket += point with a single inversion
+static void flush_batch(msm_scratch_t& s) {
+  vec384 num, lambda, x3, t;
+  size_t i;
+
+  for (i = 0; i < s.batch_len; i++) {
+    const POINTonE1_affine* b = &s.buckets[s.batch_bucket[i]];
+    const POINTonE1_affine* p = s.batch_point[i];
+
+    if (!fp_is_equal(b->X, p->X))
+      fp_sub(s.denom[i], p->X, b->X);
+    else if (fp_is_equal(b->Y, p->Y))
+      fp_add(s.denom[i], b->Y, b->Y);
+    else
+      fp_copy(s.denom[i], ZERO_384);      // b == -p
+  }
+
+  fp_batch_inv(s.denom, s.denom, s.scratch, s.batch_len);
+
+  for (i = 0; i < s.batch_len; i++) {
+    POINTonE1_affine*       b = &s.buckets[s.batch_bucket[i]];
+    const POINTonE1_affine* p = s.batch_point[i];
+
+    if (fp_is_zero(s.denom[i])) {
+      s.state[s.batch_bucket[i]] = BUCKET_EMPTY;
+      continue;
+    }
+
+    if (!fp_is_equal(b->X, p->X)) {
+      fp_sub(num, p->Y, b->Y);
+    } else {
+      fp_sqr(num, b->X);
+      fp_add(t, num, num);
+      fp_add(num, num, t);
+    }
+    fp_mul(lambda, num, s.denom[i]);
+
+    fp_sqr(x3, lambda);
+    fp_sub(x3, x3, b->X);
+    fp_sub(x3, x3, p->X);
+
+    fp_sub(t, b->X, x3);
+    fp_mul(t, t, lambda);
+    fp_sub(b->Y, t, b->Y);
+    fp_copy(b->X, x3);
+
+    s.state[s.batch_bucket[i]] = BUCKET_SET;
+  }
+
+  s.batch_len = 0;
+}
+
+static void add_to_bucket(msm_scratch_t& s, uint32_t bucket,
+                          const POINTonE1_affine* point) {
+  switch (s.state[bucket]) {
+    case BUCKET_EMPTY:
+      s.buckets[bucket] = *point;
+      s.state[bucket]   = BUCKET_SET;
+      break;
+    case BUCKET_SET:
+      s.batch_bucket[s.batch_len] = bucket;
+      s.batch_point[s.batch_len]  = point;
+      s.state[bucket]             = BUCKET_BUSY;
+      if (++s.batch_len == MSM_BATCH_SIZE)
+        flush_batch(s);
+      break;
+    default:
+      if (s.overflow[bucket] == OVERFLOW_EMPTY) {
+        POINTonE1_from_affine(&s.jbuckets[bucket], point);
+        s.overflow[bucket] = OVERFLOW_SET;
+      } else {
+        POINTonE1_add_affine(&s.jbuckets[bucket], &s.jbuckets[bucket],
+                             point);
+      }
+      break;
+  }
+}
+
+// Accumulate points [start, end) into the affine buckets, batching the
+// additions so that each flush costs a single inversion.  A bucket takes
+// at most one addition per batch, the rest go to its overflow bucket.
+static void fill_buckets_affine(msm_scratch_t& s,
+                                const POINTonE1_affine points[],
+                                const vec256 scalars[], size_t start,
+                                size_t end, size_t off, size_t bits,
+                                size_t nbuckets) {
+  uint64_t wval;
+
+  s.state.assign(nbuckets, BUCKET_EMPTY);
+  s.overflow.assign(nbuckets, OVERFLOW_EMPTY);
+  s.batch_len = 0;
+
+  for (size_t i = start; i < end; i++) {
+    if (POINTonE1_affine_is_inf(&points[i]))
+      continue;
+    wval = get_wval(scalars[i], off, bits);
+    if (wval != 0)
+      add_to_bucket(s, (uint32_t)(wval - 1), &points[i]);
+  }
+
+  if (s.batch_len != 0)
+    flush_batch(s);
+}
+
+// Sum of window bits [off, off + wbits) over points [start, end)
+static void msm_window(POINTonE1* ret, msm_scratch_t& s,
+                       const POINTonE1_affine points[],
+                       const vec256 scalars[], size_t start, size_t end,
+                       size_t off, size_t wbits) {
+  size_t   nbuckets = ((size_t)1 << wbits) - 1;
+  size_t   bits     = wbits;
+  bool     affine   = wbits >= MSM_BATCH_AFFINE_MIN_WBITS;
+  uint64_t wval;
+
+  if (off + bits > BLS12_381_r_BITS)
+    bits = BLS12_381_r_BITS - off;
+
+  if (affine) {
+    fill_buckets_affine(s, points, scalars, start, end, off, bits, nbuckets);
+  } else {
+    s.jbuckets.assign(nbuckets, POINTonE1_INF);
+    for (size_t i = start; i < end; i++) {
+      wval = get_wval(scalars[i], off, bits);
+      if (wval != 0)
+        POINTonE1_add_affine(&s.jbuckets[wval - 1], &s.jbuckets[wval - 1],
+                             &points[i]);
+    }
+  }
+
+  // sum(i * bucket[i]) as a running sum from the top bucket down
+  POINTonE1 running = POINTonE1_INF, sum = POINTonE1_INF;
+
+  for (size_t i = nbuckets; i-- > 0; ) {
+    if (!affine) {
+      POINTonE1_add(&running, &running, &s.jbuckets[i]);
+    } else {
+      if (s.state[i] == BUCKET_SET)
+        POINTonE1_add_affine(&running, &running, &s.buckets[i]);
+      if (s.overflow[i] == OVERFLOW_SET)
+        POINTonE1_add(&running, &running, &s.jbuckets[i]);
+    }
+    POINTonE1_add(&sum, &sum, &running);
+  }
+
+  *ret = sum;
+}
+
+void msm_g1_pippenger(POINTonE1* ret, const POINTonE1_affine points[],
+                      const vec256 scalars[], size_t npoints,
+                      size_t nthreads) {
+  size_t wbits    = msm_g1_window_size(npoints);
+  size_t nwindows = (BLS12_381_r_BITS + wbits - 1) / wbits;
+  size_t nchunks, chunk_size, nitems;
+
+  if (nthreads == 0)
+    nthreads = std::thread::hardware_concurrency();
+  if (nthreads == 0)
+    nthreads = 1;
+
+  // Split each window over several point ranges when there are more
+  // threads than windows
+  nchunks = (nthreads + nwindows - 1) / nwindows;
+  if (nchunks > npoints / MSM_MIN_CHUNK)
+    nchunks = npoints / MSM_MIN_CHUNK;
+  if (nchunks == 0)
+    nchunks = 1;
+  chunk_size = (npoints + nchunks - 1) / nchunks;
+  nitems     = nwindows * nchunks;
+  if (nthreads > nitems)
+    nthreads = nitems;
+
+  std::vector<POINTonE1> partial(nitems);
+  std::atomic<size_t>    next(0);
+
+  auto worker = [&]() {
+    msm_scratch_t s;
+
+    if (wbits >= MSM_BATCH_AFFINE_MIN_WBITS) {
+      s.buckets.resize(((size_t)1 << wbits) - 1);
+      s.jbuckets.resize(((size_t)1 << wbits) - 1);
+    }
+    s.batch_bucket.resize(MSM_BATCH_SIZE);
+    s.batch_point.resize(MSM_BATCH_SIZE);
+    s.denom   = new vec384[MSM_BATCH_SIZE];
+    s.scratch = new vec384[MSM_BATCH_SIZE];
+
+    for (size_t item = next++; item < nitems; item = next++) {
+      size_t window = item / nchunks;
+      size_t start  = (item % nchunks) * chunk_size;
+      size_t end    = start + chunk_size;
+
+      if (end > npoints)
+        end = npoints;
+      if (start > end)
+        start = end;
+
+      msm_window(&partial[item], s, points, scalars, start, end,
+                 window * wbits, wbits);
+    }
+
+    delete[] s.denom;
+    delete[] s.scratch;
+  };
+
+  if (nthreads == 1) {
+    worker();
+  } else {
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < nthreads; i++)
+      threads.emplace_back(worker);
+    for (auto it = threads.begin(); it != threads.end(); ++it)
+      it->join();
+  }
+
+  // Horner over the windows, most significant first
+  POINTonE1 acc = POINTonE1_INF;
+
+  for (size_t window = nwindows; window-- > 0; ) {
+    if (window != nwindows - 1) {
+      for (size_t i = 0; i < wbits; i++)
+        POINTonE1_double(&acc, &acc);
+    }
+    for (size_t chunk = 0; chunk < nchunks; chunk++)
+      POINTonE1_add(&acc, &acc, &partial[window * nchunks + chunk]);
+  }
+
+  *ret = acc;
+}
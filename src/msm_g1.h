@@ -0,0 +1,22 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_MSM_G1_H__
+#define __SUPRANATIONAL_MSM_G1_H__
+
+#include "ec_g1.h"
+
+// Bucket size in bits for the given number of points
+size_t msm_g1_window_size(size_t npoints);
+
+// ret = sum(scalars[i] * points[i]) using Pippenger's bucket method.
+// Buckets are accumulated in affine coordinates with batched inversion and
+// the (window, chunk) work items are spread over nthreads threads, where
+// 0 selects std::thread::hardware_concurrency().  Scalars are little-endian
+// 64-bit limbs of at most BLS12_381_r_BITS bits.  Variable time.
+void msm_g1_pippenger(POINTonE1* ret, const POINTonE1_affine points[],
+                      const vec256 scalars[], size_t npoints,
+                      size_t nthreads);
+
+#endif /* __SUPRANATIONAL_MSM_G1_H__ */
@@ -0,0 +1,283 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
+#include <unistd.h>
+#ifdef __linux__
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+#include "multicore.h"
+
+// Logical CPUs of one physical core
+struct multicore_core_t {
+  int              package;
+  int              core;
+  std::vector<int> cpus;
+};
+
+// Reusable barrier so every thread starts each bench together.  Threads
+// that finish early sleep rather than spin, a spinning thread would compete
+// for issue ports with an SMT sibling still timing its bench.
+struct multicore_barrier_t {
+  std::mutex              lock;
+  std::condition_variable cv;
+  size_t                  count;
+  size_t                  generation;
+  size_t                  nthreads;
+
+  void wait() {
+    std::unique_lock<std::mutex> guard(lock);
+    size_t gen = generation;
+
+    if (++count == nthreads) {
+      count = 0;
+      generation++;
+      cv.notify_all();
+    } else {
+      cv.wait(guard, [&] { return generation != gen; });
+    }
+  }
+};
+
+struct multicore_ctx_t {
+  const std::vector<bench_func_ptr_t>*    benches;
+  std::uniform_int_distribution<uint64_t> dist;
+  std::uniform_int_distribution<uint64_t> dist_upper;
+  std::vector<int>                        cpus;
+  std::vector<std::vector<BenchResult>>   results;
+  std::atomic<bool>                       pin_failed;
+  multicore_barrier_t                     barrier;
+};
+
+static int multicore_read_int(int cpu, const char* file) {
+  std::string   path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                       "/topology/" + file;
+  std::ifstream in(path);
+  int           value = -1;
+
+  in >> value;
+  return in ? value : -1;
+}
+
+// Physical cores in package/core order, with the logical CPUs this process
+// may run on
+static std::vector<multicore_core_t> multicore_topology() {
+  std::vector<multicore_core_t> cores;
+  long ncpus = sysconf(_SC_NPROCESSORS_CONF);
+
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    return cores;
+#endif
+
+  for (int cpu = 0; cpu < ncpus; cpu++) {
+#ifdef __linux__
+    if (!CPU_ISSET(cpu, &allowed))
+      continue;
+#endif
+    int package = multicore_read_int(cpu, "physical_package_id");
+    int core    = multicore_read_int(cpu, "core_id");
+
+    // Without topology information every CPU is its own core
+    if (package < 0 || core < 0) {
+      package = 0;
+      core    = -1 - cpu;
+    }
+
+    size_t i;
+    for (i = 0; i < cores.size(); i++) {
+      if (cores[i].package == package && cores[i].core == core)
+        break;
+    }
+    if (i == cores.size())
+      cores.push_back({ package, core, {} });
+    cores[i].cpus.push_back(cpu);
+  }
+
+  return cores;
+}
+
+static std::vector<int> multicore_cpus(const char* placement) {
+  std::vector<multicore_core_t> cores = multicore_topology();
+  std::vector<int>              cpus;
+
+  if (!strcmp(placement, "siblings")) {
+    for (auto& core : cores) {
+      if (core.cpus.size() >= 2) {
+        cpus.push_back(core.cpus[0]);
+        cpus.push_back(core.cpus[1]);
+      }
+    }
+  } else if (!strcmp(placement, "cores")) {
+    for (auto& core : cores)
+      cpus.push_back(core.cpus[0]);
+  } else if (!strcmp(placement, "all")) {
+    for (size_t t = 0; ; t++) {
+      size_t added = 0;
+
+      for (auto& core : cores) {
+        if (t < core.cpus.size()) {
+          cpus.push_back(core.cpus[t]);
+          added++;
+        }
+      }
+      if (added == 0)
+        break;
+    }
+  }
+
+  return cpus;
+}
+
+static bool multicore_pin(int cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+static void multicore_thread(multicore_ctx_t* ctx, size_t id) {
+  Perf perf(OUTER_ITERS_FAST, INNER_ITERS_FAST);
+  std::uniform_int_distribution<uint64_t> dist       = ctx->dist;
+  std::uniform_int_distribution<uint64_t> dist_upper = ctx->dist_upper;
+
+  if (!multicore_pin(ctx->cpus[id]))
+    ctx->pin_failed = true;
+
+  for (auto bench : *ctx->benches) {
+    if (bench == 0)
+      continue;
+    ctx->barrier.wait();
+    bench(&perf, dist, dist_upper, ctx->results[id]);
+  }
+}
+
+// Results per thread, empty if a thread could not be pinned
+static std::vector<std::vector<BenchResult>> multicore_run(
+    const std::vector<bench_func_ptr_t>& benches,
+    std::uniform_int_distribution<uint64_t>& dist,
+    std::uniform_int_distribution<uint64_t>& dist_upper,
+    const std::vector<int>& cpus) {
+  multicore_ctx_t          ctx;
+  std::vector<std::thread> threads;
+
+  ctx.benches             = &benches;
+  ctx.dist                = dist;
+  ctx.dist_upper          = dist_upper;
+  ctx.cpus                = cpus;
+  ctx.pin_failed          = false;
+  ctx.barrier.count       = 0;
+  ctx.barrier.generation  = 0;
+  ctx.barrier.nthreads    = cpus.size();
+  ctx.results.resize(cpus.size());
+
+  for (size_t i = 0; i < cpus.size(); i++)
+    threads.emplace_back(multicore_thread, &ctx, i);
+  for (auto& thread : threads)
+    thread.join();
+
+  if (ctx.pin_failed)
+    ctx.results.clear();
+
+  return ctx.results;
+}
+
+int run_multicore(const std::vector<bench_func_ptr_t>& benches,
+                  std::uniform_int_distribution<uint64_t>& dist,
+                  std::uniform_int_distribution<uint64_t>& dist_upper,
+                  const char* placement, size_t nthreads) {
+  if (strcmp(placement, "siblings") && strcmp(placement, "cores") &&
+      strcmp(placement, "all")) {
+    std::cout << "ERROR - unknown placement " << placement
+              << ", use siblings, cores or all" << std::endl;
+    return -1;
+  }
+
+  std::vector<int> cpus = multicore_cpus(placement);
+
+  if (cpus.empty()) {
+    std::cout << "ERROR - no CPUs available for placement " << placement
+              << std::endl;
+    return -1;
+  }
+  if (nthreads > cpus.size()) {
+    std::cout << "ERROR - placement " << placement << " allows at most "
+              << cpus.size() << " threads" << std::endl;
+    return -1;
+  }
+  if (nthreads != 0)
+    cpus.resize(nthreads);
+
+  std::cout << "Placement " << placement << ", " << cpus.size()
+            << " threads on CPUs";
+  for (size_t i = 0; i < cpus.size(); i++)
+    std::cout << (i == 0 ? " " : ",") << cpus[i];
+  std::cout << std::endl << std::endl;
+
+  std::vector<std::vector<BenchResult>> single =
+    multicore_run(benches, dist, dist_upper, std::vector<int>(1, cpus[0]));
+  std::vector<std::vector<BenchResult>> multi =
+    multicore_run(benches, dist, dist_upper, cpus);
+
+  if (single.empty() || multi.empty()) {
+    std::cout << "ERROR - could not pin threads to CPUs" << std::endl;
+    return -1;
+  }
+
+  // Per thread cycles/op of each bench
+  for (size_t b = 0; b < single[0].size(); b++) {
+    std::cout << single[0][b].name << std::endl;
+    std::cout << "  CPU     cyc/op" << std::endl;
+    for (size_t t = 0; t < cpus.size(); t++) {
+      std::cout << "  " << std::setw(4) << std::left << cpus[t]
+                << std::fixed << std::setprecision(1)
+                << std::setw(10) << std::right << multi[t][b].cycles_per_op
+                << std::endl;
+    }
+  }
+  std::cout << std::endl;
+
+  // Aggregate cyc/op is the per thread average spread over all threads,
+  // efficiency is single thread throughput per thread kept under load
+  std::cout << "Benchmark                         1 thread  per thread"
+            << "   aggregate  efficiency" << std::endl;
+  std::cout << "______________________________________________________"
+            << "______________________" << std::endl;
+  for (size_t b = 0; b < single[0].size(); b++) {
+    double per_thread = 0;
+
+    for (size_t t = 0; t < cpus.size(); t++)
+      per_thread += multi[t][b].cycles_per_op;
+    per_thread /= cpus.size();
+
+    std::cout << std::setw(32) << std::left << single[0][b].name
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << std::right << single[0][b].cycles_per_op
+              << std::setw(12) << std::right << per_thread
+              << std::setw(12) << std::right << per_thread / cpus.size()
+              << std::setw(11) << std::right
+              << 100.0 * single[0][b].cycles_per_op / per_thread << "%"
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_MULTICORE_H__
+#define __SUPRANATIONAL_MULTICORE_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <random>
+#include "bench.h"
+
+// Runs every bench in benches on nthreads threads at once, each pinned to
+// its own logical CPU and with its own Perf, after a single thread baseline
+// on the first of those CPUs.  placement picks the CPUs:
+//   "siblings"  SMT sibling pairs, both hardware threads of each core
+//   "cores"     one hardware thread per physical core
+//   "all"       every logical CPU, physical cores first
+// nthreads = 0 uses every CPU the placement allows.  Prints per thread and
+// aggregate cycles/op and the scaling efficiency, returns -1 if the threads
+// can't be placed.
+int run_multicore(const std::vector<bench_func_ptr_t>& benches,
+                  std::uniform_int_distribution<uint64_t>& dist,
+                  std::uniform_int_distribution<uint64_t>& dist_upper,
+                  const char* placement, size_t nthreads);
+
+#endif /* __SUPRANATIONAL_MULTICORE_H__ */
@@ -0,0 +1,254 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include "pairing.h"
+
+bool POINTonE2_affine_on_curve(const POINTonE2_affine* in) {
+  vec384x lhs, rhs, b;
+
+  fp_copy(b[0], BLS12_381_B_G1);
+  fp_copy(b[1], BLS12_381_B_G1);
+
+  fp2_sqr(lhs, in->Y);
+  fp2_sqr(rhs, in->X);
+  fp2_mul(rhs, rhs, in->X);
+  fp2_add(rhs, rhs, b);
+
+  return fp2_is_equal(lhs, rhs);
+}
+
+// Line evaluation at P, f *= c2 + (c1 * xP) * v + (c0 * yP) * v * w
+static void line_eval(vec384fp12 f, const vec384x c0, const vec384x c1,
+                      const vec384x c2, const POINTonE1_affine* P) {
+  vec384x l0, l1;
+
+  fp2_mul_by_fp(l0, c0, P->Y);
+  fp2_mul_by_fp(l1, c1, P->X);
+  fp12_mul_by_014(f, f, c2, l1, l0);
+}
+
+// Algorithm 26, https://eprint.iacr.org/2010/354.pdf
+static void doubling_step(vec384x c0, vec384x c1, vec384x c2, POINTonE2* T) {
+  vec384x t0, t1, t2, t3, t4, t5, t6, zz;
+
+  fp2_sqr(t0, T->X);
+  fp2_sqr(t1, T->Y);
+  fp2_sqr(t2, t1);
+
+  fp2_add(t3, t1, T->X);
+  fp2_sqr(t3, t3);
+  fp2_sub(t3, t3, t0);
+  fp2_sub(t3, t3, t2);
+  fp2_add(t3, t3, t3);
+
+  fp2_add(t4, t0, t0);
+  fp2_add(t4, t4, t0);
+  fp2_add(t6, T->X, t4);
+  fp2_sqr(t5, t4);
+  fp2_sqr(zz, T->Z);
+
+  fp2_sub(T->X, t5, t3);
+  fp2_sub(T->X, T->X, t3);
+
+  fp2_add(T->Z, T->Z, T->Y);
+  fp2_sqr(T->Z, T->Z);
+  fp2_sub(T->Z, T->Z, t1);
+  fp2_sub(T->Z, T->Z, zz);
+
+  fp2_sub(T->Y, t3, T->X);
+  fp2_mul(T->Y, T->Y, t4);
+  fp2_add(t2, t2, t2);
+  fp2_add(t2, t2, t2);
+  fp2_add(t2, t2, t2);
+  fp2_sub(T->Y, T->Y, t2);
+
+  // c1 = -2 * t4 * Z^2
+  fp2_mul(t3, t4, zz);
+  fp2_add(t3, t3, t3);
+  fp2_neg(c1, t3);
+
+  // c2 = (X + t4)^2 - t0 - t5 - 4 * Y^2
+  fp2_sqr(t6, t6);
+  fp2_sub(t6, t6, t0);
+  fp2_sub(t6, t6, t5);
+  fp2_add(t1, t1, t1);
+  fp2_add(t1, t1, t1);
+  fp2_sub(c2, t6, t1);
+
+  // c0 = 2 * Z' * Z^2
+  fp2_mul(t0, T->Z, zz);
+  fp2_add(c0, t0, t0);
+}
+
+// Algorithm 27, https://eprint.iacr.org/2010/354.pdf
+static void addition_step(vec384x c0, vec384x c1, vec384x c2, POINTonE2* T,
+                          const POINTonE2_affine* Q) {
+  vec384x t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, zz, yy;
+
+  fp2_sqr(zz, T->Z);
+  fp2_sqr(yy, Q->Y);
+  fp2_mul(t0, zz, Q->X);
+
+  fp2_add(t1, Q->Y, T->Z);
+  fp2_sqr(t1, t1);
+  fp2_sub(t1, t1, yy);
+  fp2_sub(t1, t1, zz);
+  fp2_mul(t1, t1, zz);
+
+  fp2_sub(t2, t0, T->X);
+  fp2_sqr(t3, t2);
+  fp2_add(t4, t3, t3);
+  fp2_add(t4, t4, t4);
+  fp2_mul(t5, t4, t2);
+
+  fp2_sub(t6, t1, T->Y);
+  fp2_sub(t6, t6, T->Y);
+  fp2_mul(t9, t6, Q->X);
+  fp2_mul(t7, t4, T->X);
+
+  fp2_sqr(T->X, t6);
+  fp2_sub(T->X, T->X, t5);
+  fp2_sub(T->X, T->X, t7);
+  fp2_sub(T->X, T->X, t7);
+
+  fp2_add(T->Z, T->Z, t2);
+  fp2_sqr(T->Z, T->Z);
+  fp2_sub(T->Z, T->Z, zz);
+  fp2_sub(T->Z, T->Z, t3);
+
+  fp2_add(t10, Q->Y, T->Z);
+
+  fp2_sub(t8, t7, T->X);
+  fp2_mul(t8, t8, t6);
+  fp2_mul(t0, T->Y, t5);
+  fp2_add(t0, t0, t0);
+  fp2_sub(T->Y, t8, t0);
+
+  // c2 = 2 * t9 - ((yQ + Z')^2 - yQ^2 - Z'^2)
+  fp2_sqr(t10, t10);
+  fp2_sub(t10, t10, yy);
+  fp2_sqr(t0, T->Z);
+  fp2_sub(t10, t10, t0);
+  fp2_add(t9, t9, t9);
+  fp2_sub(c2, t9, t10);
+
+  // c0 = 2 * Z', c1 = -2 * t6
+  fp2_add(c0, T->Z, T->Z);
+  fp2_add(t6, t6, t6);
+  fp2_neg(c1, t6);
+}
+
+void miller_loop(vec384fp12 ret, const POINTonE2_affine* Q,
+                 const POINTonE1_affine* P) {
+  vec384fp12 f;
+  vec384x    c0, c1, c2;
+  POINTonE2  T;
+
+  fp12_one(f);
+
+  if (POINTonE1_affine_is_inf(P) ||
+      (fp2_is_zero(Q->X) && fp2_is_zero(Q->Y))) {
+    fp12_copy(ret, f);
+    return;
+  }
+
+  fp2_copy(T.X, Q->X);
+  fp2_copy(T.Y, Q->Y);
+  fp_copy(T.Z[0], BLS12_381_ONE);
+  fp_copy(T.Z[1], ZERO_384);
+
+  // Skip the top bit of |x|, T starts at Q
+  for (int i = 62; i >= 0; i--) {
+    if (i != 62)
+      fp12_sqr(f, f);
+
+    doubling_step(c0, c1, c2, &T);
+    line_eval(f, c0, c1, c2, P);
+
+    if ((BLS12_381_X_ABS >> i) & 1) {
+      addition_step(c0, c1, c2, &T, Q);
+      line_eval(f, c0, c1, c2, P);
+    }
+  }
+
+  // x is negative
+  fp12_conjugate(ret, f);
+}
+
+void fp12_cyclotomic_exp(vec384fp12 ret, const vec384fp12 a,
+                         const uint64_t* scalar, size_t nbits) {
+  vec384fp12 acc;
+  bool       found_one = false;
+
+  fp12_one(acc);
+  for (size_t i = nbits; i-- > 0; ) {
+    if (found_one)
+      fp12_cyclotomic_sqr(acc, acc);
+    if ((scalar[i / 64] >> (i % 64)) & 1) {
+      fp12_mul(acc, acc, a);
+      found_one = true;
+    }
+  }
+
+  fp12_copy(ret, acc);
+}
+
+// a^x for the (negative) curve parameter x
+static void exp_by_x(vec384fp12 ret, const vec384fp12 a) {
+  const uint64_t x = BLS12_381_X_ABS;
+
+  fp12_cyclotomic_exp(ret, a, &x, 64);
+  fp12_conjugate(ret, ret);
+}
+
+// Hard part uses the addition chain of the zkcrypto bls12_381 crate
+void final_exp(vec384fp12 ret, const vec384fp12 f) {
+  vec384fp12 t0, t1, t2, t3, t4, t5, t6;
+
+  // Easy part, f^((p^6 - 1)(p^2 + 1))
+  fp12_conjugate(t0, f);
+  fp12_inv(t1, f);
+  fp12_mul(t2, t0, t1);
+  fp12_copy(t1, t2);
+  fp12_frobenius(t2, t2);
+  fp12_frobenius(t2, t2);
+  fp12_mul(t2, t2, t1);
+
+  // Hard part
+  fp12_cyclotomic_sqr(t1, t2);
+  fp12_conjugate(t1, t1);
+  exp_by_x(t3, t2);
+  fp12_cyclotomic_sqr(t4, t3);
+  fp12_mul(t5, t1, t3);
+  exp_by_x(t1, t5);
+  exp_by_x(t0, t1);
+  exp_by_x(t6, t0);
+  fp12_mul(t6, t6, t4);
+  exp_by_x(t4, t6);
+  fp12_conjugate(t5, t5);
+  fp12_mul(t5, t5, t2);
+  fp12_mul(t4, t4, t5);
+  fp12_conjugate(t5, t2);
+  fp12_mul(t1, t1, t2);
+  fp12_frobenius(t1, t1);
+  fp12_frobenius(t1, t1);
+  fp12_frobenius(t1, t1);
+  fp12_mul(t6, t6, t5);
+  fp12_frobenius(t6, t6);
+  fp12_mul(t3, t3, t0);
+  fp12_frobenius(t3, t3);
+  fp12_frobenius(t3, t3);
+  fp12_mul(t3, t3, t1);
+  fp12_mul(t3, t3, t6);
+  fp12_mul(ret, t3, t4);
+}
+
+void pairing(vec384fp12 ret, const POINTonE1_affine* P,
+             const POINTonE2_affine* Q) {
+  vec384fp12 f;
+
+  miller_loop(f, Q, P);
+  final_exp(ret, f);
+}
@@ -0,0 +1,56 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_PAIRING_H__
+#define __SUPRANATIONAL_PAIRING_H__
+
+#include "ec_g1.h"
+#include "fp12.h"
+
+// BLS12-381 optimal ate pairing built from the EVM384 primitives.
+// G2 lives on the M-type twist y^2 = x^3 + 4(u + 1) over Fp2.
+
+struct POINTonE2 {
+  vec384x X, Y, Z;
+};
+
+struct POINTonE2_affine {
+  vec384x X, Y;
+};
+
+// Generator in Montgomery form
+const POINTonE2_affine BLS12_381_G2 = {
+  { { 0xf5f28fa202940a10, 0xb3f5fb2687b4961a,
+      0xa1a893b53e2ae580, 0x9894999d1a3caee9,
+      0x6f67b7631863366b, 0x058191924350bcd7 },
+    { 0xa5a9c0759e23f606, 0xaaa0c59dbccd60c3,
+      0x3bb17e18e2867806, 0x1b1ab6cc8541b367,
+      0xc2b6ed0ef2158547, 0x11922a097360edf3 } },
+  { { 0x4c730af860494c4a, 0x597cfa1f5e369c5a,
+      0xe7e6856caa0a635a, 0xbbefb5e96e0d495f,
+      0x07d3a975f0ef25a2, 0x0083fd8e7e80dae5 },
+    { 0xadc0fc92df64b05d, 0x18aa270a2b1461dc,
+      0x86adac6a3be4eba0, 0x79495c4ec93da33a,
+      0xe7175850a43ccaed, 0x0b2bc2a163de1bf2 } }
+};
+
+// |x| where x = -0xd201000000010000 is the BLS12-381 curve parameter
+#define BLS12_381_X_ABS 0xd201000000010000ULL
+
+bool POINTonE2_affine_on_curve(const POINTonE2_affine* in);
+
+void miller_loop(vec384fp12 ret, const POINTonE2_affine* Q,
+                 const POINTonE1_affine* P);
+
+// Raises f to 3 * (p^12 - 1) / r, the same power as blst and zkcrypto
+void final_exp(vec384fp12 ret, const vec384fp12 f);
+
+void pairing(vec384fp12 ret, const POINTonE1_affine* P,
+             const POINTonE2_affine* Q);
+
+// Exponentiation by a public scalar in the cyclotomic subgroup
+void fp12_cyclotomic_exp(vec384fp12 ret, const vec384fp12 a,
+                         const uint64_t* scalar, size_t nbits);
+
+#endif /* __SUPRANATIONAL_PAIRING_H__ */
@@ -104,8 +104,8 @@ uint64_t Perf::get_cycles_per_sec() {
   double cycle_per_inst = (double) cycles / (iters * inner_cycles);
 
   if ((cycle_per_inst > 1.01) || (cycle_per_inst < 0.99)) {
-    std::cout << "ERROR - clock frequency is not stable" << std::endl;
-    std::cout << "cycle_per_inst not +/-1.0 : " << cycle_per_inst << std::endl;
+    std::cerr << "ERROR - clock frequency is not stable" << std::endl;
+    std::cerr << "cycle_per_inst not +/-1.0 : " << cycle_per_inst << std::endl;
     return 0;
   }
 
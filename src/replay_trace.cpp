@@ -0,0 +1,181 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Replays an add/sub/mul trace recorded through trace.h over a preallocated
+// operand arena.  Build with -DEVM384_TRACE_OPS to enable -record-pairing,
+// which records one BLS12-381 pairing as a sample workload.
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <locale>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+
+#include "perf.h"
+#include "trace.h"
+
+#ifdef EVM384_TRACE_OPS
+# include "pairing.h"
+#endif
+
+#define REPLAY_OUTER_ITERS 10
+
+static const char* trace_op_names[TRACE_NUM_OPS] = { "Add", "Sub", "Mul" };
+
+// Average cycles of one pass over ops, arena is reset before every pass
+static void replay_cycles(Perf* perf, vec384 arena[], const trace_t* trace,
+                          const std::vector<trace_op_t>& ops) {
+  size_t arena_bytes = trace->header->nslots * sizeof(vec384);
+
+  // Warm up
+  memcpy(arena, trace->slots, arena_bytes);
+  trace_replay(arena, trace->moduli, ops.data(), ops.size());
+
+  for (int i = 0; i < REPLAY_OUTER_ITERS; i++) {
+    memcpy(arena, trace->slots, arena_bytes);
+    perf->start_collection();
+    trace_replay(arena, trace->moduli, ops.data(), ops.size());
+    perf->end_collection(i);
+  }
+}
+
+int main(int argc, char **argv) {
+  bool        skip_cycle_check = false;
+  const char* record_path      = NULL;
+  const char* trace_path       = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp("-skip-cycle-check", argv[i])) {
+      skip_cycle_check = true;
+    } else if (!strcmp("-record-pairing", argv[i]) && i + 1 < argc) {
+      record_path = argv[++i];
+    } else {
+      trace_path = argv[i];
+    }
+  }
+
+  if (record_path != NULL) {
+#ifdef EVM384_TRACE_OPS
+    vec384fp12 f;
+
+    if (!trace_open(record_path)) {
+      std::cout << "ERROR - could not create " << record_path << std::endl;
+      return -1;
+    }
+    pairing(f, &BLS12_381_G1, &BLS12_381_G2);
+    if (!trace_close()) {
+      std::cout << "ERROR - could not write " << record_path << std::endl;
+      return -1;
+    }
+    if (trace_path == NULL)
+      trace_path = record_path;
+#else
+    std::cout << "ERROR - rebuild with -DEVM384_TRACE_OPS to record"
+              << std::endl;
+    return -1;
+#endif
+  }
+
+  if (trace_path == NULL) {
+    std::cout << "Usage: " << argv[0]
+              << " [-skip-cycle-check] [-record-pairing FILE] [TRACE]"
+              << std::endl;
+    return -1;
+  }
+
+  trace_t trace;
+  if (!trace_map(&trace, trace_path)) {
+    std::cout << "ERROR - " << trace_path << " is not a valid trace"
+              << std::endl;
+    return -1;
+  }
+
+  Perf perf(REPLAY_OUTER_ITERS, 1);
+
+  // Check for stable CPU clock frequency
+  uint64_t  cycles_per_sec = perf.get_cycles_per_sec();
+
+  if (cycles_per_sec == 0) {
+    if (skip_cycle_check) {
+      std::cout << "Unstable frequency!! Proceeding anyway" << std::endl;
+    } else {
+      std::cout << "Skipping benchmark runs - unstable frequency" << std::endl;
+      trace_unmap(&trace);
+      return -1;
+    }
+  }
+
+  std::cout.imbue(std::locale(""));
+  std::cout << "CPU cyc/sec: " << std::fixed << cycles_per_sec << std::endl;
+  std::cout << "Trace: " << trace_path << ", "
+            << trace.header->nops << " ops, "
+            << trace.header->nslots << " slots, "
+            << trace.header->nmoduli << " moduli" << std::endl;
+  std::cout.imbue(std::locale());
+  std::cout << std::endl;
+
+  auto startClock = std::chrono::system_clock::now();
+  std::time_t startTime = std::chrono::system_clock::to_time_t(startClock);
+  std::cout << "Run date: " << std::ctime(&startTime) << std::endl;
+
+  vec384* arena = new vec384[trace.header->nslots];
+
+  // Full trace, then each opcode on its own with the same operand slots
+  std::vector<trace_op_t> all_ops(trace.ops, trace.ops + trace.header->nops);
+  std::vector<trace_op_t> op_ops[TRACE_NUM_OPS];
+
+  for (size_t i = 0; i < all_ops.size(); i++)
+    op_ops[all_ops[i].opcode].push_back(all_ops[i]);
+
+  replay_cycles(&perf, arena, &trace, all_ops);
+  double total_cycles = perf.get_cycles_per_op(REPLAY_OUTER_ITERS, 1);
+  double total_nsecs  = perf.get_nsecs_per_op(REPLAY_OUTER_ITERS, 1);
+
+  std::cout << "Ops            count      total cyc     cyc/op     ns/op"
+            << "   share" << std::endl;
+  std::cout << "______________________________________________________"
+            << "__________" << std::endl;
+  std::cout << std::setw(8) << std::left << "Replay"
+            << std::setw(12) << std::right << all_ops.size()
+            << std::setprecision(0)
+            << std::setw(15) << std::right << total_cycles
+            << std::setprecision(1)
+            << std::setw(11) << std::right
+            << total_cycles / std::max<size_t>(all_ops.size(), 1)
+            << std::setw(10) << std::right
+            << total_nsecs / std::max<size_t>(all_ops.size(), 1)
+            << std::setw(7) << std::right << 100.0 << "%" << std::endl;
+
+  for (int op = 0; op < TRACE_NUM_OPS; op++) {
+    if (op_ops[op].empty())
+      continue;
+
+    replay_cycles(&perf, arena, &trace, op_ops[op]);
+    double cycles = perf.get_cycles_per_op(REPLAY_OUTER_ITERS, 1);
+    double nsecs  = perf.get_nsecs_per_op(REPLAY_OUTER_ITERS, 1);
+
+    std::cout << std::setw(8) << std::left << trace_op_names[op]
+              << std::setw(12) << std::right << op_ops[op].size()
+              << std::setprecision(0)
+              << std::setw(15) << std::right << cycles
+              << std::setprecision(1)
+              << std::setw(11) << std::right << cycles / op_ops[op].size()
+              << std::setw(10) << std::right << nsecs / op_ops[op].size()
+              << std::setw(7) << std::right << 100.0 * cycles / total_cycles
+              << "%" << std::endl;
+  }
+
+  delete[] arena;
+  trace_unmap(&trace);
+
+  std::cout << std::endl;
+  auto endClock = std::chrono::system_clock::now();
+  std::chrono::duration<double> runTime = endClock - startClock;
+  std::cout << "Total runtime is: " << runTime.count() << " secs" << std::endl;
+
+  return 0;
+}
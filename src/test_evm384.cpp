@@ -8,6 +8,12 @@
 #include <cstring>
 #include <random>
 #include "blst_evm384.h"
+#include "blst_evm384_inline.h"
+#include "blst_evm384_vartime.h"
+#include "msm_g1.h"
+#include "pairing.h"
+#include "trace.h"
+#include "batch.h"
 
 #define TEST_ITERATIONS 100000000
 
@@ -25,9 +31,81 @@ int compare_vec384(vec384 out_asm, vec384 out_no_asm, const char* func) {
     return 0;
 }
 
+// e(G1, G2), not in Montgomery form.  Computed with an independent affine
+// Miller loop over the flat representation Fp[w] / (w^12 - 2w^6 + 2) and a
+// direct exponentiation by 3 * (p^12 - 1) / r, the exponent implemented by
+// the final_exp addition chain and used by the common test vectors.
+const uint64_t PAIRING_G1_G2[2][3][2][6] = {
+  { { { 0xa84305aaca1789b6, 0xb6d194f60839c508,
+        0x3dd8e90ce98db3e7, 0x272d441befa15c50,
+        0xa7b2d83168d0d727, 0x1250ebd871fc0a92 },
+      { 0x59882a98eaa0170f, 0xf1a8943e50439f1d,
+        0xaf5af689452eafab, 0x68a84045483c92b7,
+        0x86750ec6a5323488, 0x089a1c5b46e5110b } },
+    { { 0x881c4c849ec23e87, 0xddff57309396b38c,
+        0x16da0e22a5031b54, 0x0378a68e72a6b3b2,
+        0x9703f239689ce34c, 0x1368bb445c7c2d20 },
+      { 0x315021ec3c19934f, 0xffe51d7a579973b1,
+        0x7c90d8bd66065b1f, 0x37e0794e1e65a761,
+        0xc273fa075a505129, 0x193502b86edb8857 } },
+    { { 0x1dad1c1fb597aaa5, 0x19c34dffbbaad843,
+        0x185203fcca589ac7, 0xfbf2f8da752f7c74,
+        0x91125ba84dc4007c, 0x01b2f522473d1713 },
+      { 0x8beae9624045b4b6, 0x23f7dacaa35c8ca7,
+        0x8061e55cceba478b, 0x46da634b8f6be14a,
+        0xbd3c79937a45b845, 0x018107154f25a764 } } },
+  { { { 0x0f948226e47ee89d, 0xbb12d58386a8703e,
+        0xdea54d43b2b73f2c, 0xc88784fbb3d0b2db,
+        0x9cd6bd15c3d5a04d, 0x19f26337d205fb46 },
+      { 0x102ae1c2d5d5ab1a, 0x1bfd1b68ff02f0b8,
+        0xa7d2809d61bfe02e, 0xd5857baaf222eb95,
+        0x9f80940ca771b6ff, 0x06fba23eb7c5af0d } },
+    { { 0x1b93b47333e2ba57, 0x78ef48881e32fac9,
+        0x7d0d15ff7b984e89, 0xc81a93b330ee1a67,
+        0xfcef68083b0b0ec5, 0x11b8b424cd48bf38 },
+      { 0xbe2291a0c25a99a2, 0x7ba810c5a09ffdd9,
+        0x20c806ad36082910, 0xc6a0e9786ab59733,
+        0xc31b4fcb6ce5771c, 0x03350f55a7aefcd3 } },
+    { { 0x9108f0242d0fe3ef, 0xa4fafc05066245cb,
+        0x1c7cdba7b3872629, 0xa189e87935a95405,
+        0x02249b64728ffd21, 0x04c581234d086a99 },
+      { 0xfde449383b676631, 0xd48eaa24afe47e1e,
+        0xdeff686bfd6df543, 0x3baca4d72ca93544,
+        0x068672cbd01a7ec7, 0x0f41e58663bf08cf } } }
+};
+
+// [a]G1 and [b]G2, not in Montgomery form
+const uint64_t PAIRING_A = 0x2a5f7d1c93e4b6a8;
+const uint64_t PAIRING_B = 0x61c3e9f07b2d4a15;
+
+const uint64_t PAIRING_A_G1[2][6] = {
+  { 0x0e8f9932f719d2b8, 0xebb4f774c5ca1a03,
+    0x0e980f7cc26328df, 0x46b4041eed567025,
+    0x745c3fcd855b1197, 0x002c9e33203102fa },
+  { 0x8a5bf840fabe400c, 0x4d14ab6b725823a2,
+    0x03f1f150040408c8, 0x4bc52159a47aa427,
+    0x44e4425930d4ef5d, 0x0c1bc9647d96ba9c }
+};
+
+const uint64_t PAIRING_B_G2[2][2][6] = {
+  { { 0xf2a90f3fe08053eb, 0x544048dccfb88546,
+      0x732027ab2c5abffb, 0x5e976a885f3ff6cf,
+      0x9c40160d786f1d81, 0x07b7d88552e6b95f },
+    { 0xc637edebbb383d99, 0x27e94fd475fb1b3f,
+      0xee5e878fc9fb74ee, 0xada5b47b2ff36fcc,
+      0x9154c2df22223acb, 0x027b5117181f32f8 } },
+  { { 0x7a2925292e5b655e, 0xb30c876157a64d94,
+      0x20b3c2a1515da0be, 0x212b8224354c0f20,
+      0x27a2767a0b186b8e, 0x0a9dc00f60336634 },
+    { 0x8ff98890d5beef27, 0x3f95a611b6de0796,
+      0x7b818eb3b02b1aa1, 0x32a16ddb186c6bc0,
+      0x2aa11eb8552f76ce, 0x0c73235d252e6a4d } }
+};
+
 int test_evm_384(size_t iters) {
   vec384 x, y; 
   vec384 out_asm, out_no_asm;
+  vec384 a2[2], b2[2], out_x2[2], io2[2];
 
   std::mt19937_64 gen(1);\
 
@@ -53,6 +131,18 @@ int test_evm_384(size_t iters) {
       return -1;
     }
 
+    add_mod_384_inline(out_no_asm, x, y, BLS12_381_P);
+
+    if (compare_vec384(out_asm, out_no_asm, "Add inline") != 0) {
+      return -1;
+    }
+
+    add_mod_384_vartime(out_no_asm, x, y, BLS12_381_P);
+
+    if (compare_vec384(out_asm, out_no_asm, "Add vartime") != 0) {
+      return -1;
+    }
+
     sub_mod_384(out_asm, x, y, BLS12_381_P);
     sub_mod_384_no_asm(out_no_asm, x, y, BLS12_381_P);
 
@@ -60,23 +150,428 @@ int test_evm_384(size_t iters) {
       return -1;
     }
 
+    sub_mod_384_inline(out_no_asm, x, y, BLS12_381_P);
+
+    if (compare_vec384(out_asm, out_no_asm, "Sub inline") != 0) {
+      return -1;
+    }
+
+    sub_mod_384_vartime(out_no_asm, x, y, BLS12_381_P);
+
+    if (compare_vec384(out_asm, out_no_asm, "Sub vartime") != 0) {
+      return -1;
+    }
+
     mul_mont_384(out_asm, x, y, BLS12_381_P, BLS12_381_p0);
     mul_mont_384_no_asm(out_no_asm, x, y, BLS12_381_P, BLS12_381_p0);
 
     if (compare_vec384(out_asm, out_no_asm, "Mul") != 0) {
       return -1;
     }
+
+    // Second stream takes the operands swapped and doubled
+    std::memcpy(a2[0], x, sizeof(vec384));
+    std::memcpy(b2[0], y, sizeof(vec384));
+    std::memcpy(a2[1], y, sizeof(vec384));
+    add_mod_384(b2[1], x, x, BLS12_381_P);
+    mul_mont_384x2(out_x2, a2, b2, BLS12_381_P, BLS12_381_p0);
+    mul_mont_384_no_asm(out_no_asm, b2[1], y, BLS12_381_P, BLS12_381_p0);
+
+    if (compare_vec384(out_x2[0], out_asm, "Mulx2") != 0 ||
+        compare_vec384(out_x2[1], out_no_asm, "Mulx2") != 0) {
+      return -1;
+    }
+
+    // In place, ret is a for both lanes, then ret is b
+    std::memcpy(io2, a2, sizeof(io2));
+    mul_mont_384x2(io2, io2, b2, BLS12_381_P, BLS12_381_p0);
+
+    if (compare_vec384(io2[0], out_x2[0], "Mulx2 ret == a") != 0 ||
+        compare_vec384(io2[1], out_x2[1], "Mulx2 ret == a") != 0) {
+      return -1;
+    }
+
+    std::memcpy(io2, b2, sizeof(io2));
+    mul_mont_384x2(io2, a2, io2, BLS12_381_P, BLS12_381_p0);
+
+    if (compare_vec384(io2[0], out_x2[0], "Mulx2 ret == b") != 0 ||
+        compare_vec384(io2[1], out_x2[1], "Mulx2 ret == b") != 0) {
+      return -1;
+    }
   }
 
   return 0;
 }
 
+int test_msm_g1() {
+  const size_t sizes[]   = { 1, 2, 5, 64, 300, 2100, 8200 };
+  const size_t threads[] = { 1, 64 };
+  const size_t max_size  = 8200;
+
+  POINTonE1_affine* points  = new POINTonE1_affine[max_size];
+  POINTonE1*        jpoints = new POINTonE1[max_size];
+  vec256*           scalars = new vec256[max_size];
+  POINTonE1         acc, term, expected, out;
+
+  std::mt19937_64 gen(1);
+
+  std::uniform_int_distribution<uint64_t>
+    rng(0, std::numeric_limits<uint64_t>::max());
+
+  // RNG for last limb to ensure scalar < order
+  std::uniform_int_distribution<uint64_t>
+    rng_upper(0, BLS12_381_r[3]);
+
+  // Generator must be on the curve and of order r
+  POINTonE1_from_affine(&acc, &BLS12_381_G1);
+  POINTonE1_mult(&out, &acc, BLS12_381_r, BLS12_381_r_BITS);
+  if (!POINTonE1_affine_on_curve(&BLS12_381_G1) || !POINTonE1_is_inf(&out)) {
+    std::cout << "ERROR - bad G1 generator" << std::endl;
+    return -1;
+  }
+
+  // Multiples of the generator, with repeats and negations mixed in to
+  // exercise the doubling and cancellation paths of the bucket additions
+  for (size_t i = 0; i < max_size; i++) {
+    jpoints[i] = acc;
+    if (i % 7 == 3)
+      jpoints[i] = jpoints[i / 2];
+    if (i % 11 == 5) {
+      jpoints[i] = jpoints[i - 1];
+      fp_neg(jpoints[i].Y, jpoints[i].Y);
+    }
+    POINTonE1_add_affine(&acc, &acc, &BLS12_381_G1);
+  }
+  POINTonE1_batch_to_affine(points, jpoints, max_size);
+
+  for (size_t i = 0; i < max_size; i++) {
+    if (!POINTonE1_affine_on_curve(&points[i])) {
+      std::cout << "ERROR - MSM input point not on curve" << std::endl;
+      return -1;
+    }
+    for (size_t k = 0; k < 3; ++k) {
+      scalars[i][k] = rng(gen);
+    }
+    scalars[i][3] = rng_upper(gen);
+    // Keep the reference scalar multiplications cheap for large sizes
+    if (i >= 2100)
+      scalars[i][1] = scalars[i][2] = scalars[i][3] = 0;
+    if (i % 13 == 0)
+      scalars[i][0] = scalars[i][1] = scalars[i][2] = scalars[i][3] = 0;
+  }
+
+  for (size_t n : sizes) {
+    expected = POINTonE1_INF;
+    for (size_t i = 0; i < n; i++) {
+      POINTonE1_mult(&term, &jpoints[i], scalars[i],
+                     i >= 2100 ? 64 : BLS12_381_r_BITS);
+      POINTonE1_add(&expected, &expected, &term);
+    }
+
+    for (size_t t : threads) {
+      msm_g1_pippenger(&out, points, scalars, n, t);
+      if (!POINTonE1_is_equal(&out, &expected)) {
+        std::cout << "ERROR - mismatch in MSM, npoints " << std::dec << n
+                  << " nthreads " << t << std::endl;
+        return -1;
+      }
+    }
+  }
+
+  // Equal scalars, as in aggregate signature verification, put every point
+  // of a window in the same bucket
+  for (size_t i = 1; i < max_size; i++)
+    std::memcpy(scalars[i], scalars[0], sizeof(vec256));
+
+  for (size_t n : sizes) {
+    acc = POINTonE1_INF;
+    for (size_t i = 0; i < n; i++)
+      POINTonE1_add(&acc, &acc, &jpoints[i]);
+    POINTonE1_mult(&expected, &acc, scalars[0], BLS12_381_r_BITS);
+
+    for (size_t t : threads) {
+      msm_g1_pippenger(&out, points, scalars, n, t);
+      if (!POINTonE1_is_equal(&out, &expected)) {
+        std::cout << "ERROR - mismatch in MSM with equal scalars, npoints "
+                  << std::dec << n << " nthreads " << t << std::endl;
+        return -1;
+      }
+    }
+  }
+
+  delete[] points;
+  delete[] jpoints;
+  delete[] scalars;
+
+  return 0;
+}
+
+int test_pairing() {
+  vec384fp12       e, e_ab, expected;
+  POINTonE1_affine aP;
+  POINTonE2_affine bQ;
+  uint64_t         ab[2];
+  __uint128_t      ab_wide;
+
+  if (!POINTonE2_affine_on_curve(&BLS12_381_G2)) {
+    std::cout << "ERROR - bad G2 generator" << std::endl;
+    return -1;
+  }
+
+  for (size_t i = 0; i < 2; i++)
+    for (size_t j = 0; j < 3; j++)
+      for (size_t k = 0; k < 2; k++)
+        fp_to_mont(expected[i][j][k], PAIRING_G1_G2[i][j][k]);
+
+  pairing(e, &BLS12_381_G1, &BLS12_381_G2);
+  if (!fp12_is_equal(e, expected)) {
+    std::cout << "ERROR - mismatch in pairing e(G1, G2)" << std::endl;
+    return -1;
+  }
+
+  // e^r == 1
+  fp12_cyclotomic_exp(expected, e, BLS12_381_r, BLS12_381_r_BITS);
+  if (!fp12_is_one(expected)) {
+    std::cout << "ERROR - pairing result not of order r" << std::endl;
+    return -1;
+  }
+
+  // e([a]G1, [b]G2) == e(G1, G2)^(a * b)
+  fp_to_mont(aP.X, PAIRING_A_G1[0]);
+  fp_to_mont(aP.Y, PAIRING_A_G1[1]);
+  for (size_t i = 0; i < 2; i++) {
+    fp_to_mont(bQ.X[i], PAIRING_B_G2[0][i]);
+    fp_to_mont(bQ.Y[i], PAIRING_B_G2[1][i]);
+  }
+  if (!POINTonE1_affine_on_curve(&aP) || !POINTonE2_affine_on_curve(&bQ)) {
+    std::cout << "ERROR - pairing input point not on curve" << std::endl;
+    return -1;
+  }
+
+  ab_wide = (__uint128_t)PAIRING_A * PAIRING_B;
+  ab[0]   = (uint64_t)ab_wide;
+  ab[1]   = (uint64_t)(ab_wide >> 64);
+
+  pairing(e_ab, &aP, &bQ);
+  fp12_cyclotomic_exp(expected, e, ab, 128);
+  if (!fp12_is_equal(e_ab, expected)) {
+    std::cout << "ERROR - pairing is not bilinear" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+int test_trace() {
+  const char*     path     = "test_evm384.trc";
+  const size_t    nvals    = 8;
+  const size_t    nops     = 1000;
+  vec384          vals[nvals];
+  vec384*         expected = new vec384[nops];
+  vec384*         arena;
+  trace_t         trace;
+  std::mt19937_64 gen(3);
+  int             ret      = 0;
+
+  std::uniform_int_distribution<uint64_t>
+    rng(0, std::numeric_limits<uint64_t>::max());
+
+  for (size_t i = 0; i < nvals; i++) {
+    for (size_t k = 0; k < 5; k++)
+      vals[i][k] = rng(gen);
+    vals[i][5] = rng(gen) % BLS12_381_P[5];
+  }
+
+  // Random chain over a few slots, including in place and aliased operands
+  if (!trace_open(path)) {
+    std::cout << "ERROR - could not create " << path << std::endl;
+    delete[] expected;
+    return -1;
+  }
+  if (trace_open(path)) {
+    std::cout << "ERROR - second trace_open while recording" << std::endl;
+    delete[] expected;
+    return -1;
+  }
+  for (size_t i = 0; i < nops; i++) {
+    uint64_t* r = vals[rng(gen) % nvals];
+    uint64_t* a = vals[rng(gen) % nvals];
+    uint64_t* b = vals[rng(gen) % nvals];
+
+    switch (i % 3) {
+      case 0: trace_add_mod_384(r, a, b, BLS12_381_P); break;
+      case 1: trace_sub_mod_384(r, a, b, BLS12_381_P); break;
+      default: trace_mul_mont_384(r, a, b, BLS12_381_P, BLS12_381_p0); break;
+    }
+    memcpy(expected[i], r, sizeof(vec384));
+  }
+  if (!trace_close() || !trace_map(&trace, path)) {
+    std::cout << "ERROR - could not round trip " << path << std::endl;
+    delete[] expected;
+    return -1;
+  }
+
+  if (trace.header->nops != nops || trace.header->nslots != nvals ||
+      trace.header->nmoduli != 1) {
+    std::cout << "ERROR - unexpected trace header" << std::endl;
+    ret = -1;
+  }
+
+  // Replay one op at a time and check every result
+  arena = new vec384[trace.header->nslots];
+  memcpy(arena, trace.slots, trace.header->nslots * sizeof(vec384));
+  for (size_t i = 0; ret == 0 && i < nops; i++) {
+    trace_replay(arena, trace.moduli, &trace.ops[i], 1);
+    if (compare_vec384(arena[trace.ops[i].ret], expected[i], "Replay") != 0)
+      ret = -1;
+  }
+
+  delete[] arena;
+  delete[] expected;
+  trace_unmap(&trace);
+  remove(path);
+
+  return ret;
+}
+
+int test_batch() {
+  const size_t    n = 3 * BATCH_PREFETCH_DISTANCE + 5;
+  vec384*         a = new vec384[n];
+  vec384*         b = new vec384[n];
+  vec384*         r = new vec384[n];
+  vec384          expected;
+  std::mt19937_64 gen(4);
+  int             ret = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    for (size_t k = 0; k < 5; k++) {
+      a[i][k] = gen();
+      b[i][k] = gen();
+    }
+    a[i][5] = gen() % BLS12_381_P[5];
+    b[i][5] = gen() % BLS12_381_P[5];
+  }
+
+  add_mod_384_batch(r, a, b, BLS12_381_P, n);
+  for (size_t i = 0; ret == 0 && i < n; i++) {
+    add_mod_384(expected, a[i], b[i], BLS12_381_P);
+    ret = compare_vec384(r[i], expected, "Add batch");
+  }
+
+  sub_mod_384_batch(r, a, b, BLS12_381_P, n);
+  for (size_t i = 0; ret == 0 && i < n; i++) {
+    sub_mod_384(expected, a[i], b[i], BLS12_381_P);
+    ret = compare_vec384(r[i], expected, "Sub batch");
+  }
+
+  // In place, ret is the same array as a
+  std::memcpy(r, a, n * sizeof(vec384));
+  mul_mont_384_batch(r, r, b, BLS12_381_P, BLS12_381_p0, n);
+  for (size_t i = 0; ret == 0 && i < n; i++) {
+    mul_mont_384(expected, a[i], b[i], BLS12_381_P, BLS12_381_p0);
+    ret = compare_vec384(r[i], expected, "Mul batch");
+  }
+
+  delete[] a;
+  delete[] b;
+  delete[] r;
+
+  return ret;
+}
+
+// Operands with zero limbs and values at the edges of the reduction take
+// the early exits of the vartime compare against p
+int test_vartime(size_t iters) {
+  vec384 x, y, out_asm, out_vartime;
+  const vec384 zero = { 0 };
+  const vec384 one  = { 1 };
+  vec384 p_minus_one;
+  int ret = 0;
+
+  std::mt19937_64 gen(1);
+
+  std::uniform_int_distribution<uint64_t>
+    rng(0, std::numeric_limits<uint64_t>::max());
+
+  std::uniform_int_distribution<uint64_t>
+    rng_upper(0, BLS12_381_P[5]);
+
+  sub_mod_384(p_minus_one, zero, one, BLS12_381_P);
+
+  for (size_t i = 0; ret == 0 && i < iters; ++i) {
+    uint64_t zeros = rng(gen);
+
+    for (size_t k = 0; k < 6; ++k) {
+      x[k] = (zeros >> k) & 1 ? 0 : rng(gen);
+      y[k] = (zeros >> (k + 6)) & 1 ? 0 : rng(gen);
+    }
+    if (x[5] > BLS12_381_P[5])
+      x[5] = rng_upper(gen);
+    if (y[5] > BLS12_381_P[5])
+      y[5] = rng_upper(gen);
+
+    // Every few iterations an operand is 0, 1 or p - 1
+    switch ((zeros >> 12) & 15) {
+      case 0: std::memcpy(x, zero, sizeof(vec384)); break;
+      case 1: std::memcpy(y, one, sizeof(vec384)); break;
+      case 2: std::memcpy(x, p_minus_one, sizeof(vec384)); break;
+      case 3: std::memcpy(y, p_minus_one, sizeof(vec384)); break;
+      case 4: std::memcpy(y, x, sizeof(vec384)); break;
+    }
+
+    add_mod_384(out_asm, x, y, BLS12_381_P);
+    add_mod_384_vartime(out_vartime, x, y, BLS12_381_P);
+    ret |= compare_vec384(out_asm, out_vartime, "Add vartime");
+
+    sub_mod_384(out_asm, x, y, BLS12_381_P);
+    sub_mod_384_vartime(out_vartime, x, y, BLS12_381_P);
+    ret |= compare_vec384(out_asm, out_vartime, "Sub vartime");
+
+    // In place, ret is the same as a
+    std::memcpy(out_vartime, x, sizeof(vec384));
+    sub_mod_384_vartime(out_vartime, out_vartime, y, BLS12_381_P);
+    ret |= compare_vec384(out_asm, out_vartime, "Sub vartime");
+  }
+
+  return ret;
+}
+
 int main() {
   std::cout << "Comparing " << TEST_ITERATIONS
-            << " iterations of asm with no asm for add, sub, and mul"
+            << " iterations of asm with no asm for add, sub, mul and mul x2, and with inline and vartime for add and sub"
             << std::endl;
   if (!test_evm_384(TEST_ITERATIONS)) {
     std::cout << "SUCCESS!" << std::endl;
   }
+
+  std::cout << "Comparing G1 Pippenger MSM with sum of scalar multiplications, random and equal scalars"
+            << std::endl;
+  if (!test_msm_g1()) {
+    std::cout << "SUCCESS!" << std::endl;
+  }
+
+  std::cout << "Comparing BLS12-381 pairing with known values and bilinearity"
+            << std::endl;
+  if (!test_pairing()) {
+    std::cout << "SUCCESS!" << std::endl;
+  }
+
+  std::cout << "Comparing replayed op trace with recorded results"
+            << std::endl;
+  if (!test_trace()) {
+    std::cout << "SUCCESS!" << std::endl;
+  }
+
+  std::cout << "Comparing vartime kernels with asm on sparse and edge operands"
+            << std::endl;
+  if (!test_vartime(TEST_ITERATIONS / 100)) {
+    std::cout << "SUCCESS!" << std::endl;
+  }
+
+  std::cout << "Comparing prefetching batch kernels with single calls"
+            << std::endl;
+  if (!test_batch()) {
+    std::cout << "SUCCESS!" << std::endl;
+  }
   return 0;
 }
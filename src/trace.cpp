@@ -0,0 +1,261 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "trace.h"
+
+struct trace_recorder_t {
+  FILE*                                        file;
+  uint64_t                                     nops;
+  bool                                         failed;
+  std::unordered_map<const uint64_t*, uint32_t> slot_ids;
+  std::vector<uint64_t>                        slots;   // 6 limbs per slot
+  std::vector<trace_modulus_t>                 moduli;
+};
+
+static trace_recorder_t recorder;
+
+static uint32_t trace_slot(const uint64_t* addr, bool capture) {
+  auto it = recorder.slot_ids.find(addr);
+
+  if (it != recorder.slot_ids.end())
+    return it->second;
+
+  uint32_t id = (uint32_t)recorder.slot_ids.size();
+  recorder.slot_ids[addr] = id;
+  for (size_t i = 0; i < 6; i++)
+    recorder.slots.push_back(capture ? addr[i] : 0);
+
+  return id;
+}
+
+// Returns the modulus id, or -1 once the id space is exhausted
+static int trace_modulus(const uint64_t* p, uint64_t n0) {
+  size_t i;
+
+  for (i = 0; i < recorder.moduli.size(); i++) {
+    if (memcmp(recorder.moduli[i].p, p, sizeof(vec384)) == 0)
+      break;
+  }
+
+  if (i == recorder.moduli.size()) {
+    trace_modulus_t m;
+
+    if (i == TRACE_MAX_MODULI)
+      return -1;
+    memcpy(m.p, p, sizeof(vec384));
+    m.n0 = 0;
+    recorder.moduli.push_back(m);
+  }
+  if (n0 != 0)
+    recorder.moduli[i].n0 = n0;
+
+  return (int)i;
+}
+
+static void trace_record(uint8_t opcode, const uint64_t* ret,
+                         const uint64_t* a, const uint64_t* b,
+                         const uint64_t* p, uint64_t n0) {
+  trace_op_t op;
+  int        modulus;
+
+  if (recorder.failed)
+    return;
+
+  modulus = trace_modulus(p, n0);
+  if (modulus < 0) {
+    recorder.failed = true;
+    return;
+  }
+
+  // Inputs first so a slot read and written by the same op keeps its value
+  op.opcode   = opcode;
+  op.modulus  = (uint8_t)modulus;
+  op.reserved = 0;
+  op.a        = trace_slot(a, true);
+  op.b        = trace_slot(b, true);
+  op.ret      = trace_slot(ret, false);
+
+  if (fwrite(&op, sizeof(op), 1, recorder.file) != 1)
+    recorder.failed = true;
+  recorder.nops++;
+}
+
+bool trace_open(const char* path) {
+  trace_header_t header;
+
+  // One recording at a time
+  if (recorder.file != NULL)
+    return false;
+
+  recorder.file = fopen(path, "wb");
+  if (recorder.file == NULL)
+    return false;
+
+  recorder.nops   = 0;
+  recorder.failed = false;
+  recorder.slot_ids.clear();
+  recorder.slots.clear();
+  recorder.moduli.clear();
+
+  // Placeholder, rewritten with the final counts by trace_close
+  memset(&header, 0, sizeof(header));
+  if (fwrite(&header, sizeof(header), 1, recorder.file) != 1) {
+    fclose(recorder.file);
+    recorder.file = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+bool trace_close() {
+  trace_header_t header;
+  bool           ok;
+
+  if (recorder.file == NULL)
+    return false;
+
+  memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+  header.nmoduli = (uint32_t)recorder.moduli.size();
+  header.nslots  = (uint32_t)recorder.slot_ids.size();
+  header.nops    = recorder.nops;
+
+  ok = !recorder.failed;
+  ok = ok && fwrite(recorder.moduli.data(), sizeof(trace_modulus_t),
+                    recorder.moduli.size(), recorder.file) ==
+             recorder.moduli.size();
+  ok = ok && fwrite(recorder.slots.data(), sizeof(uint64_t),
+                    recorder.slots.size(), recorder.file) ==
+             recorder.slots.size();
+  ok = ok && fseek(recorder.file, 0, SEEK_SET) == 0;
+  ok = ok && fwrite(&header, sizeof(header), 1, recorder.file) == 1;
+  ok = (fclose(recorder.file) == 0) && ok;
+
+  recorder.file = NULL;
+  recorder.slot_ids.clear();
+  recorder.slots.clear();
+  recorder.moduli.clear();
+
+  return ok;
+}
+
+void trace_add_mod_384(vec384 ret, const vec384 a, const vec384 b,
+                       const vec384 p) {
+  if (recorder.file != NULL)
+    trace_record(TRACE_OP_ADD, ret, a, b, p, 0);
+  add_mod_384(ret, a, b, p);
+}
+
+void trace_sub_mod_384(vec384 ret, const vec384 a, const vec384 b,
+                       const vec384 p) {
+  if (recorder.file != NULL)
+    trace_record(TRACE_OP_SUB, ret, a, b, p, 0);
+  sub_mod_384(ret, a, b, p);
+}
+
+void trace_mul_mont_384(vec384 ret, const vec384 a, const vec384 b,
+                        const vec384 p, uint64_t n0) {
+  if (recorder.file != NULL)
+    trace_record(TRACE_OP_MUL, ret, a, b, p, n0);
+  mul_mont_384(ret, a, b, p, n0);
+}
+
+bool trace_map(trace_t* trace, const char* path) {
+  struct stat st;
+  int         fd;
+  size_t      expected;
+
+  memset(trace, 0, sizeof(*trace));
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(trace_header_t)) {
+    close(fd);
+    return false;
+  }
+
+  trace->size = st.st_size;
+  trace->map  = mmap(NULL, trace->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (trace->map == MAP_FAILED) {
+    trace->map = NULL;
+    return false;
+  }
+
+  trace->header = (const trace_header_t*)trace->map;
+  if (trace->header->nops > trace->size / sizeof(trace_op_t)) {
+    trace_unmap(trace);
+    return false;
+  }
+
+  expected = sizeof(trace_header_t) +
+             trace->header->nops    * sizeof(trace_op_t) +
+             trace->header->nmoduli * sizeof(trace_modulus_t) +
+             trace->header->nslots  * sizeof(vec384);
+
+  if (memcmp(trace->header->magic, TRACE_MAGIC, sizeof(trace->header->magic))
+      || trace->header->nmoduli > TRACE_MAX_MODULI
+      || trace->size != expected) {
+    trace_unmap(trace);
+    return false;
+  }
+
+  trace->ops    = (const trace_op_t*)(trace->header + 1);
+  trace->moduli = (const trace_modulus_t*)(trace->ops + trace->header->nops);
+  trace->slots  = (const vec384*)(trace->moduli + trace->header->nmoduli);
+
+  // Validate once here so the replay loop needs no checks
+  for (uint64_t i = 0; i < trace->header->nops; i++) {
+    const trace_op_t* op = &trace->ops[i];
+
+    if (op->opcode >= TRACE_NUM_OPS ||
+        op->modulus >= trace->header->nmoduli ||
+        op->ret >= trace->header->nslots ||
+        op->a   >= trace->header->nslots ||
+        op->b   >= trace->header->nslots ||
+        (op->opcode == TRACE_OP_MUL && trace->moduli[op->modulus].n0 == 0)) {
+      trace_unmap(trace);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void trace_unmap(trace_t* trace) {
+  if (trace->map != NULL)
+    munmap(trace->map, trace->size);
+  memset(trace, 0, sizeof(*trace));
+}
+
+void trace_replay(vec384 arena[], const trace_modulus_t moduli[],
+                  const trace_op_t ops[], size_t nops) {
+  for (size_t i = 0; i < nops; i++) {
+    const trace_op_t*      op = &ops[i];
+    const trace_modulus_t* m  = &moduli[op->modulus];
+
+    switch (op->opcode) {
+      case TRACE_OP_ADD:
+        add_mod_384(arena[op->ret], arena[op->a], arena[op->b], m->p);
+        break;
+      case TRACE_OP_SUB:
+        sub_mod_384(arena[op->ret], arena[op->a], arena[op->b], m->p);
+        break;
+      default:
+        mul_mont_384(arena[op->ret], arena[op->a], arena[op->b], m->p, m->n0);
+        break;
+    }
+  }
+}
@@ -0,0 +1,93 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_TRACE_H__
+#define __SUPRANATIONAL_TRACE_H__
+
+#include <cstdint>
+#include <cstddef>
+#include "blst_evm384.h"
+
+// Recording shim around add_mod_384/sub_mod_384/mul_mont_384 and the
+// matching replay engine.
+//
+// Every distinct operand address seen while recording becomes a slot in an
+// operand arena and every distinct modulus gets an id.  Slot values are
+// captured the first time a slot is read, values stored by code outside the
+// traced calls (fp_copy, struct copies) are not, so a replay computes on
+// different values than the recorded run.  A trace is only valid as a
+// timing workload for the constant time kernels, not for checking results
+// of a whole computation.  Recording is not thread safe.
+//
+// File layout, native endian:
+//   trace_header_t
+//   trace_op_t      ops[nops]
+//   trace_modulus_t moduli[nmoduli]
+//   vec384          slots[nslots]     initial arena contents
+
+#define TRACE_MAGIC       "EVM384T1"
+#define TRACE_MAX_MODULI  256
+
+enum trace_opcode_t {
+  TRACE_OP_ADD = 0,
+  TRACE_OP_SUB = 1,
+  TRACE_OP_MUL = 2,
+  TRACE_NUM_OPS
+};
+
+struct trace_header_t {
+  char     magic[8];
+  uint32_t nmoduli;
+  uint32_t nslots;
+  uint64_t nops;
+};
+
+struct trace_op_t {
+  uint8_t  opcode;
+  uint8_t  modulus;
+  uint16_t reserved;
+  uint32_t ret;
+  uint32_t a;
+  uint32_t b;
+};
+
+struct trace_modulus_t {
+  vec384   p;
+  uint64_t n0;                         // 0 if only used by add/sub
+};
+
+// Start recording to path, returns false if the file can't be created or
+// written or if a recording is already open.
+// The traced calls pass straight through while no recording is open.
+bool trace_open(const char* path);
+
+// Write the modulus and slot tables, returns false on a write error
+bool trace_close();
+
+void trace_add_mod_384(vec384 ret, const vec384 a, const vec384 b,
+                       const vec384 p);
+void trace_sub_mod_384(vec384 ret, const vec384 a, const vec384 b,
+                       const vec384 p);
+void trace_mul_mont_384(vec384 ret, const vec384 a, const vec384 b,
+                        const vec384 p, uint64_t n0);
+
+// Read-only mapping of a recorded trace
+struct trace_t {
+  void*                  map;
+  size_t                 size;
+  const trace_header_t*  header;
+  const trace_op_t*      ops;
+  const trace_modulus_t* moduli;
+  const vec384*          slots;
+};
+
+// mmap and validate a trace file, returns false if it is malformed
+bool trace_map(trace_t* trace, const char* path);
+void trace_unmap(trace_t* trace);
+
+// Execute ops over arena, which must hold header->nslots elements
+void trace_replay(vec384 arena[], const trace_modulus_t moduli[],
+                  const trace_op_t ops[], size_t nops);
+
+#endif /* __SUPRANATIONAL_TRACE_H__ */
@@ -0,0 +1,191 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <random>
+#include <unistd.h>
+
+#include "bench.h"
+#include "batch.h"
+#include "working_set.h"
+
+// Each timed sample covers at least this many elements, repeating passes
+// over the smaller tiers
+#define WORKING_SET_MIN_ELEMENTS (1 << 20)
+
+// Bytes of a, b and ret per element
+#define WORKING_SET_ELEMENT_BYTES (3 * sizeof(vec384))
+
+typedef void (*batch_func_t)(vec384 ret[], const vec384 a[], const vec384 b[],
+                             size_t n);
+
+struct working_set_tier_t {
+  const char* name;
+  size_t      bytes;
+};
+
+// Plain loops of kernel calls and the prefetching batch path, all on the
+// BLS12-381 modulus
+static void add_plain(vec384 ret[], const vec384 a[], const vec384 b[],
+                      size_t n) {
+  for (size_t i = 0; i < n; i++)
+    add_mod_384(ret[i], a[i], b[i], BLS12_381_P);
+}
+
+static void sub_plain(vec384 ret[], const vec384 a[], const vec384 b[],
+                      size_t n) {
+  for (size_t i = 0; i < n; i++)
+    sub_mod_384(ret[i], a[i], b[i], BLS12_381_P);
+}
+
+static void mul_plain(vec384 ret[], const vec384 a[], const vec384 b[],
+                      size_t n) {
+  for (size_t i = 0; i < n; i++)
+    mul_mont_384(ret[i], a[i], b[i], BLS12_381_P, BLS12_381_p0);
+}
+
+static void add_prefetch(vec384 ret[], const vec384 a[], const vec384 b[],
+                         size_t n) {
+  add_mod_384_batch(ret, a, b, BLS12_381_P, n);
+}
+
+static void sub_prefetch(vec384 ret[], const vec384 a[], const vec384 b[],
+                         size_t n) {
+  sub_mod_384_batch(ret, a, b, BLS12_381_P, n);
+}
+
+static void mul_prefetch(vec384 ret[], const vec384 a[], const vec384 b[],
+                         size_t n) {
+  mul_mont_384_batch(ret, a, b, BLS12_381_P, BLS12_381_p0, n);
+}
+
+struct working_set_op_t {
+  const char*  name;
+  batch_func_t plain;
+  batch_func_t prefetch;
+};
+
+static const working_set_op_t working_set_ops[] = {
+  { "Add", add_plain, add_prefetch },
+  { "Sub", sub_plain, sub_prefetch },
+  { "Mul", mul_plain, mul_prefetch },
+};
+
+static size_t working_set_cache_size(int name, size_t fallback) {
+  long size = sysconf(name);
+
+  return size > 0 ? (size_t)size : fallback;
+}
+
+static double working_set_cycles(Perf* perf, batch_func_t func, vec384 ret[],
+                                 const vec384 a[], const vec384 b[],
+                                 size_t n) {
+  size_t passes = std::max<size_t>(1, WORKING_SET_MIN_ELEMENTS / n);
+
+  func(ret, a, b, n);
+
+  for (int i = 0; i < OUTER_ITERS_FAST; i++) {
+    perf->start_collection();
+    for (size_t j = 0; j < passes; j++)
+      func(ret, a, b, n);
+    perf->end_collection(i);
+  }
+
+  return (double)perf->calc_mean(OUTER_ITERS_FAST) / (passes * n);
+}
+
+static void print_bytes(size_t bytes) {
+  if (bytes >= ((size_t)1 << 20))
+    std::cout << std::setw(8) << std::right << (bytes >> 20) << " MB";
+  else
+    std::cout << std::setw(8) << std::right << (bytes >> 10) << " KB";
+}
+
+void run_working_set(Perf* perf, size_t max_bytes) {
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+  size_t l1 = working_set_cache_size(_SC_LEVEL1_DCACHE_SIZE, 32 << 10);
+  size_t l2 = working_set_cache_size(_SC_LEVEL2_CACHE_SIZE,  1 << 20);
+  size_t l3 = working_set_cache_size(_SC_LEVEL3_CACHE_SIZE,  32 << 20);
+#else
+  size_t l1 = 32 << 10, l2 = 1 << 20, l3 = 32 << 20;
+#endif
+
+  // Half of each cache leaves room for everything else, DRAM is well past
+  // L3 so the prefetchers can't hide it
+  working_set_tier_t tiers[] = {
+    { "L1",   l1 / 2 },
+    { "L2",   l2 / 2 },
+    { "L3",   l3 / 2 },
+    { "DRAM", std::min(std::max(4 * l3, (size_t)256 << 20), max_bytes) },
+  };
+
+  // A cap that leaves the DRAM tier within reach of L3 would time L3 again
+  // under the DRAM label, so that tier is dropped instead
+  size_t ntiers = sizeof(tiers) / sizeof(tiers[0]);
+
+  if (tiers[ntiers - 1].bytes < 2 * l3) {
+    std::cout << "Skipping DRAM tier, " << (max_bytes >> 20)
+              << " MB cap is below 2x L3 (" << (2 * l3 >> 20) << " MB)"
+              << std::endl << std::endl;
+    ntiers--;
+  }
+
+  size_t max_n = 0;
+  for (size_t t = 0; t < ntiers; t++)
+    max_n = std::max(max_n, tiers[t].bytes / WORKING_SET_ELEMENT_BYTES);
+
+  vec384* a   = new vec384[max_n];
+  vec384* b   = new vec384[max_n];
+  vec384* ret = new vec384[max_n];
+
+  std::mt19937_64 gen(1);
+  std::uniform_int_distribution<uint64_t> rng_upper(0, BLS12_381_P[5] - 1);
+
+  for (size_t i = 0; i < max_n; i++) {
+    for (size_t k = 0; k < 5; k++) {
+      a[i][k]   = gen();
+      b[i][k]   = gen();
+      ret[i][k] = 0;
+    }
+    a[i][5]   = rng_upper(gen);
+    b[i][5]   = rng_upper(gen);
+    ret[i][5] = 0;
+  }
+
+  std::cout << "Working set, cycles per element with separate a, b and ret"
+            << std::endl;
+  std::cout << "Tier    Elements    Working set  Op      Plain  Prefetch"
+            << "  Speedup" << std::endl;
+  std::cout << "____________________________________________________________"
+            << "_________" << std::endl;
+
+  for (size_t t = 0; t < ntiers; t++) {
+    const working_set_tier_t& tier = tiers[t];
+    size_t n = std::max<size_t>(1, tier.bytes / WORKING_SET_ELEMENT_BYTES);
+
+    for (auto& op : working_set_ops) {
+      double plain    = working_set_cycles(perf, op.plain, ret, a, b, n);
+      double prefetch = working_set_cycles(perf, op.prefetch, ret, a, b, n);
+
+      std::cout << std::setw(6) << std::left << tier.name
+                << std::setw(10) << std::right << n
+                << "    ";
+      print_bytes(n * WORKING_SET_ELEMENT_BYTES);
+      std::cout << "  " << std::setw(4) << std::left << op.name
+                << std::fixed << std::setprecision(1)
+                << std::setw(9) << std::right << plain
+                << std::setw(10) << std::right << prefetch
+                << std::setprecision(2)
+                << std::setw(8) << std::right << plain / prefetch << "x"
+                << std::endl;
+    }
+  }
+
+  delete[] a;
+  delete[] b;
+  delete[] ret;
+}
@@ -0,0 +1,23 @@
+// Copyright Supranational LLC
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef __SUPRANATIONAL_WORKING_SET_H__
+#define __SUPRANATIONAL_WORKING_SET_H__
+
+#include <cstdint>
+#include <cstddef>
+#include "perf.h"
+
+// Default cap on the DRAM tier working set
+#define WORKING_SET_MAX_BYTES ((size_t)1 << 30)
+
+// Streams add/sub/mul over operand arrays sized to half of L1, L2 and L3 and
+// to several times L3 (DRAM, at most max_bytes), once as a plain loop of
+// kernel calls and once through the prefetching batch path, and prints
+// cycles per element for each tier.  The DRAM tier is skipped if max_bytes
+// is below 2x L3.  perf must hold at least
+// OUTER_ITERS_FAST results.
+void run_working_set(Perf* perf, size_t max_bytes);
+
+#endif /* __SUPRANATIONAL_WORKING_SET_H__ */